@@ -1,89 +1,277 @@
 #include "audio.h"
+#include "mixer.h"
+#include "sfx_samples.h"
+#include "melodies.h"
+#include "perf.h"
 #include <M5Unified.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+static const uint8_t* const VICTORY_JINGLES[THEME_COUNT] = {
+  MEL_VICTORY_PLAINS, MEL_VICTORY_ISLAND, MEL_VICTORY_SWAMP, MEL_VICTORY_MOUNTAIN, MEL_VICTORY_FOREST
+};
+
+// Equal-tempered octave 8 (MIDI 108-119); lower octaves are right shifts.
+static const uint16_t NOTE_FREQ_OCT8[12] PROGMEM = {
+  4186, 4435, 4699, 4978, 5274, 5588, 5920, 6272, 6645, 7040, 7459, 7902
+};
+
+enum AudioCommand : uint8_t {
+  AUDIO_CMD_PLAY,
+  AUDIO_CMD_STOP
+};
+
+struct AudioRequest {
+  AudioCommand cmd;
+  uint8_t priority;
+  const uint8_t* melody;
+  uint16_t toneFreq;
+  uint16_t toneMs;
+};
+
+struct AudioVoice {
+  AudioRequest req;
+  uint16_t pc;
+  uint16_t loopPc;
+  uint8_t loopLeft;
+  uint8_t msPerTick;
+  uint8_t gapTicks;
+  bool active;
+};
+
+static QueueHandle_t audioQueue = nullptr;
+static AudioVoice voice;
+static AudioRequest pending[AUDIO_PENDING_MAX];
+static uint8_t pendingCount = 0;
+static volatile bool audioPlaying = false;
+
+static uint16_t midiToFreq(uint8_t note) {
+  uint8_t octave = note / 12;
+  uint16_t f = pgm_read_word(&NOTE_FREQ_OCT8[note % 12]);
+  return (octave >= 9) ? f << (octave - 9) : f >> (9 - octave);
+}
+
+static void startVoice(const AudioRequest& req) {
+  voice.req = req;
+  voice.pc = 0;
+  voice.loopLeft = 0;
+  voice.msPerTick = 10;
+  voice.gapTicks = 0;
+  voice.active = true;
+}
+
+// Runs melody opcodes until the next note. Returns false at MEL_END.
+static bool nextNote(AudioVoice& v, uint16_t& freq, uint16_t& soundMs, uint16_t& stepMs) {
+  if (!v.req.melody) {
+    if (v.pc++ > 0) return false;
+    freq = v.req.toneFreq;
+    soundMs = stepMs = v.req.toneMs;
+    return true;
+  }
+
+  const uint8_t* mel = v.req.melody;
+  for (;;) {
+    uint8_t op = pgm_read_byte(&mel[v.pc++]);
+    uint8_t ticks;
+    switch (op) {
+      case MEL_END:
+        return false;
+      case MEL_TEMPO:
+        v.msPerTick = pgm_read_byte(&mel[v.pc++]);
+        continue;
+      case MEL_GAP:
+        v.gapTicks = pgm_read_byte(&mel[v.pc++]);
+        continue;
+      case MEL_LOOP:
+        v.loopLeft = pgm_read_byte(&mel[v.pc++]);
+        v.loopPc = v.pc;
+        continue;
+      case MEL_ENDLOOP:
+        if (v.loopLeft > 1) {
+          v.loopLeft--;
+          v.pc = v.loopPc;
+        }
+        continue;
+      case MEL_HZ:
+        freq = (pgm_read_byte(&mel[v.pc]) << 8) | pgm_read_byte(&mel[v.pc + 1]);
+        ticks = pgm_read_byte(&mel[v.pc + 2]);
+        v.pc += 3;
+        break;
+      default:
+        freq = op ? midiToFreq(op) : 0;
+        ticks = pgm_read_byte(&mel[v.pc++]);
+        break;
+    }
+    stepMs = (uint16_t)ticks * v.msPerTick;
+    uint16_t gapMs = (uint16_t)v.gapTicks * v.msPerTick;
+    soundMs = (stepMs > gapMs) ? stepMs - gapMs : stepMs;
+    return true;
+  }
+}
+
+static void enqueuePending(const AudioRequest& req) {
+  if (pendingCount >= AUDIO_PENDING_MAX) return;
+  uint8_t pos = pendingCount;
+  while (pos > 0 && pending[pos - 1].priority < req.priority) {
+    pending[pos] = pending[pos - 1];
+    pos--;
+  }
+  pending[pos] = req;
+  pendingCount++;
+}
+
+static bool acceptRequest(const AudioRequest& req) {
+  if (req.cmd == AUDIO_CMD_STOP) {
+    voice.active = false;
+    pendingCount = 0;
+    M5.Speaker.stop(AUDIO_TONE_CHANNEL);
+    return false;
+  }
+
+  uint8_t current = voice.active ? voice.req.priority : 0;
+  if (!voice.active || req.priority > current ||
+      (req.priority == current && req.priority < AUDIO_PRI_JINGLE)) {
+    startVoice(req);
+    return true;
+  }
+  if (req.priority == current) {
+    enqueuePending(req);
+  }
+  return false;
+}
+
+// Plays the next note and returns the ticks until the one after it. The
+// voice stays active through the last note's step so queued jingles do
+// not cut it short.
+static TickType_t advanceVoice() {
+  uint16_t freq, soundMs, stepMs;
+  while (!nextNote(voice, freq, soundMs, stepMs)) {
+    voice.active = false;
+    if (pendingCount == 0) return 0;
+    startVoice(pending[0]);
+    memmove(&pending[0], &pending[1], sizeof(AudioRequest) * (pendingCount - 1));
+    pendingCount--;
+  }
+
+  if (freq > 0) {
+    M5.Speaker.tone(freq, soundMs, AUDIO_TONE_CHANNEL);
+  }
+  return pdMS_TO_TICKS(stepMs);
+}
+
+static void audioTask(void*) {
+  TickType_t noteDue = 0;
+  AudioRequest req;
+
+  for (;;) {
+    TickType_t wait = portMAX_DELAY;
+    if (voice.active) {
+      TickType_t now = xTaskGetTickCount();
+      wait = ((int32_t)(noteDue - now) > 0) ? noteDue - now : 0;
+    }
+
+    if (xQueueReceive(audioQueue, &req, wait) == pdTRUE) {
+      if (acceptRequest(req)) noteDue = xTaskGetTickCount();
+    } else if (voice.active) {
+      noteDue = xTaskGetTickCount() + advanceVoice();
+    }
+    audioPlaying = voice.active;
+  }
+}
 
 void audioInit() {
   M5.Speaker.setVolume(SPEAKER_VOLUME);
+  audioQueue = xQueueCreate(AUDIO_QUEUE_LEN, sizeof(AudioRequest));
+  TaskHandle_t task = nullptr;
+  xTaskCreate(audioTask, "audio", AUDIO_TASK_STACK, nullptr, AUDIO_TASK_PRIORITY, &task);
+  perfWatchTask(task, "audio");
+  mixerInit();
+}
+
+static void submit(const AudioRequest& req) {
+  if (!audioQueue) return;
+  xQueueSend(audioQueue, &req, 0);
+}
+
+void audioPlay(const uint8_t* melody, AudioPriority priority) {
+  AudioRequest req = {};
+  req.cmd = AUDIO_CMD_PLAY;
+  req.priority = priority;
+  req.melody = melody;
+  submit(req);
+}
+
+void audioTone(uint16_t freq, uint16_t durationMs, AudioPriority priority) {
+  AudioRequest req = {};
+  req.cmd = AUDIO_CMD_PLAY;
+  req.priority = priority;
+  req.toneFreq = freq;
+  req.toneMs = durationMs;
+  submit(req);
+}
+
+void audioStop() {
+  AudioRequest req = {};
+  req.cmd = AUDIO_CMD_STOP;
+  submit(req);
+}
+
+bool audioBusy() {
+  return audioPlaying;
 }
 
 void audioLifeUp() {
-  M5.Speaker.tone(TONE_LIFE_UP, TONE_DURATION);
+  audioTone(TONE_LIFE_UP, TONE_DURATION);
 }
 
 void audioLifeDown() {
-  M5.Speaker.tone(TONE_LIFE_DOWN, TONE_DURATION);
+  audioTone(TONE_LIFE_DOWN, TONE_DURATION);
 }
 
 void audioDiceRoll() {
-  for (int i = 0; i < 5; i++) {
-    M5.Speaker.tone(800 + i * 100, 40);
-    delay(50);
-  }
-  M5.Speaker.tone(TONE_DICE_ROLL, 150);
+  audioPlay(MEL_DICE_ROLL, AUDIO_PRI_SFX);
 }
 
 void audioCoinFlip() {
-  M5.Speaker.tone(TONE_COIN_FLIP, 60);
-  delay(80);
-  M5.Speaker.tone(TONE_COIN_FLIP + 200, 60);
-  delay(80);
-  M5.Speaker.tone(TONE_COIN_FLIP + 400, 100);
+  audioPlay(MEL_COIN_FLIP, AUDIO_PRI_SFX);
 }
 
 void audioConfirm() {
-  M5.Speaker.tone(TONE_CONFIRM, 100);
+  audioTone(TONE_CONFIRM, 100);
 }
 
 void audioDefeat() {
-  M5.Speaker.tone(440, 200);
-  delay(220);
-  M5.Speaker.tone(370, 200);
-  delay(220);
-  M5.Speaker.tone(330, 200);
-  delay(220);
-  M5.Speaker.tone(TONE_DEFEAT, 400);
+  audioPlay(MEL_DEFEAT, AUDIO_PRI_JINGLE);
 }
 
 void audioStartup() {
-  M5.Speaker.tone(523, 80);
-  delay(100);
-  M5.Speaker.tone(659, 80);
-  delay(100);
-  M5.Speaker.tone(784, 80);
-  delay(100);
-  M5.Speaker.tone(1047, 150);
-}
-
-void audioVictory() {
-  M5.Speaker.tone(523, 120);
-  delay(140);
-  M5.Speaker.tone(659, 120);
-  delay(140);
-  M5.Speaker.tone(784, 120);
-  delay(140);
-  M5.Speaker.tone(1047, 300);
-  delay(320);
-  M5.Speaker.tone(1047, 200);
+  audioPlay(MEL_STARTUP, AUDIO_PRI_JINGLE);
+}
+
+void audioVictory(ThemeId theme) {
+  audioPlay(VICTORY_JINGLES[theme], AUDIO_PRI_JINGLE);
 }
 
+// Minigame effects go through the mixer so rapid hits, points and attacks
+// overlap instead of cutting each other off.
+static const MixerSound SFX_POINT = { WAVE_SQUARE, 140, 1318, 1760, 60, nullptr, 0, 0 };
+static const MixerSound SFX_HIT_THUMP = { WAVE_PCM, 255, 0, 0, 0, SAMPLE_THUMP, sizeof(SAMPLE_THUMP), SFX_SAMPLE_RATE };
+static const MixerSound SFX_HIT_NOISE = { WAVE_NOISE, 120, 0, 0, 60, nullptr, 0, 0 };
+static const MixerSound SFX_ATTACK = { WAVE_TRIANGLE, 200, 1500, 1800, 90, nullptr, 0, 0 };
+
 void audioGamePoint() {
-  M5.Speaker.tone(1318, 50);
+  mixerPlay(SFX_POINT);
 }
 
 void audioGameHit() {
-  M5.Speaker.tone(200, 100);
+  mixerPlay(SFX_HIT_THUMP);
+  mixerPlay(SFX_HIT_NOISE);
 }
 
 void audioGameOver() {
-  M5.Speaker.tone(392, 150);
-  delay(170);
-  M5.Speaker.tone(330, 150);
-  delay(170);
-  M5.Speaker.tone(262, 300);
+  audioPlay(MEL_GAME_OVER, AUDIO_PRI_JINGLE);
 }
 
 void audioGameAttack() {
-  M5.Speaker.tone(1500, 40);
-  delay(50);
-  M5.Speaker.tone(1800, 40);
+  mixerPlay(SFX_ATTACK);
 }
-
@@ -3,14 +3,30 @@
 
 #include "config.h"
 
+// Sounds are melodies in flash (see melodies.h) played by a background
+// task, so every audio*() call returns immediately. A request with a higher
+// priority than the playing melody cancels it; an equal one replaces it,
+// except jingles, which queue behind each other. Lower-priority requests
+// are dropped.
+enum AudioPriority {
+  AUDIO_PRI_UI,
+  AUDIO_PRI_SFX,
+  AUDIO_PRI_JINGLE
+};
+
 void audioInit();
+void audioPlay(const uint8_t* melody, AudioPriority priority);
+void audioTone(uint16_t freq, uint16_t durationMs, AudioPriority priority = AUDIO_PRI_UI);
+void audioStop();
+bool audioBusy();
+
 void audioLifeUp();
 void audioLifeDown();
 void audioDiceRoll();
 void audioCoinFlip();
 void audioConfirm();
 void audioDefeat();
-void audioVictory();
+void audioVictory(ThemeId theme);
 void audioStartup();
 void audioGamePoint();
 void audioGameHit();
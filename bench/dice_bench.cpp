@@ -0,0 +1,70 @@
+// Host-side fairness and throughput benchmark for the dice PRNG.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. bench/dice_bench.cpp -o bench/dice_bench && bench/dice_bench [rolls] [seed]
+//
+// Each die gets its own stream, exactly as on the device, and every roll
+// goes through prngStateBelow, the same bounded sampler as gameRollDice.
+
+#include "prng.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const uint32_t DICE[] = { 4, 6, 8, 10, 12, 20, 100 };
+static const double Z_999 = 3.0902;
+
+// Wilson-Hilferty approximation of the chi-square critical value.
+static double chiSquareCritical(double df, double z) {
+  double a = 2.0 / (9.0 * df);
+  double t = 1.0 - a + z * std::sqrt(a);
+  return df * t * t * t;
+}
+
+int main(int argc, char** argv) {
+  uint64_t rolls = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 10000000ULL;
+  uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], nullptr, 0) : 0xC0FFEEu;
+
+  printf("rolls per die: %llu  seed: 0x%08X\n\n", (unsigned long long)rolls, seed);
+  printf("%-5s %12s %6s %12s %10s %8s %14s\n", "die", "chi2", "df", "crit(0.001)", "max dev%", "result", "Mrolls/s");
+
+  bool allPass = true;
+  for (size_t d = 0; d < sizeof(DICE) / sizeof(DICE[0]); d++) {
+    uint32_t sides = DICE[d];
+    PrngState st;
+    prngStateSeed(st, seed, (uint32_t)d);
+    std::vector<uint64_t> hist(sides, 0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < rolls; i++) {
+      hist[prngStateBelow(st, sides)]++;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(t1 - t0).count();
+
+    double expected = (double)rolls / sides;
+    double chi2 = 0;
+    double maxDev = 0;
+    for (uint32_t f = 0; f < sides; f++) {
+      double diff = (double)hist[f] - expected;
+      chi2 += diff * diff / expected;
+      double dev = std::fabs(diff) / expected * 100.0;
+      if (dev > maxDev) maxDev = dev;
+    }
+
+    double df = sides - 1;
+    double crit = chiSquareCritical(df, Z_999);
+    bool pass = chi2 < crit;
+    allPass = allPass && pass;
+
+    char name[8];
+    snprintf(name, sizeof(name), "d%u", sides);
+    printf("%-5s %12.2f %6.0f %12.2f %10.4f %8s %14.1f\n",
+           name, chi2, df, crit, maxDev, pass ? "PASS" : "FAIL", rolls / secs / 1e6);
+  }
+
+  printf("\n%s\n", allPass ? "all dice uniform at p=0.001" : "uniformity check FAILED");
+  return allPass ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// Host-side benchmark for the minigame collision broadphase.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. bench/grid_bench.cpp -o bench/grid_bench && bench/grid_bench [frames] [seed]
+//
+// For each entity count, every entity looks up its neighbours within
+// RADIUS px, once by brute force over all pairs and once through
+// SpatialGrid (rebuild included). The pair counts must match exactly.
+
+#include "spatial_grid.h"
+#include "prng.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const int16_t FIELD_W = 240;
+static const int16_t FIELD_H = 135;
+static const float RADIUS = 8.0f;
+static const uint16_t MAX_N = 1024;
+static const uint16_t COUNTS[] = { 64, 256, 1024 };
+
+struct Point {
+  float x, y;
+};
+
+static SpatialGrid<MAX_N, FIELD_W, FIELD_H> grid;
+
+static bool near(const Point& a, const Point& b) {
+  float dx = a.x - b.x;
+  float dy = a.y - b.y;
+  return dx * dx + dy * dy < RADIUS * RADIUS;
+}
+
+static uint64_t bruteForce(const std::vector<Point>& pts) {
+  uint64_t pairs = 0;
+  for (size_t i = 0; i < pts.size(); i++) {
+    for (size_t j = i + 1; j < pts.size(); j++) {
+      if (near(pts[i], pts[j])) pairs++;
+    }
+  }
+  return pairs;
+}
+
+static uint64_t gridPairs(const std::vector<Point>& pts) {
+  grid.begin();
+  for (size_t i = 0; i < pts.size(); i++) grid.add(i, pts[i].x, pts[i].y);
+  grid.build();
+
+  uint64_t pairs = 0;
+  for (size_t i = 0; i < pts.size(); i++) {
+    const Point& p = pts[i];
+    grid.query(p.x - RADIUS, p.y - RADIUS, p.x + RADIUS, p.y + RADIUS, [&](uint16_t j) {
+      if (j > i && near(p, pts[j])) pairs++;
+    });
+  }
+  return pairs;
+}
+
+template <typename F>
+static double timeUs(F&& fn, uint32_t frames, uint64_t& result) {
+  auto t0 = std::chrono::steady_clock::now();
+  uint64_t total = 0;
+  for (uint32_t f = 0; f < frames; f++) total += fn();
+  auto t1 = std::chrono::steady_clock::now();
+  result = total / frames;
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / frames;
+}
+
+int main(int argc, char** argv) {
+  uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], nullptr, 10) : 200;
+  uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], nullptr, 0) : 0xC0FFEEu;
+
+  printf("field %dx%d  radius %.0f  frames %u  seed 0x%08X\n\n", FIELD_W, FIELD_H, RADIUS, frames, seed);
+  printf("%6s %10s %12s %12s %8s\n", "n", "pairs", "brute us", "grid us", "speedup");
+
+  bool ok = true;
+  for (uint16_t n : COUNTS) {
+    PrngState rng;
+    prngStateSeed(rng, seed, n);
+    std::vector<Point> pts(n);
+    for (Point& p : pts) {
+      p.x = prngStateBelow(rng, FIELD_W * 16) / 16.0f;
+      p.y = prngStateBelow(rng, FIELD_H * 16) / 16.0f;
+    }
+
+    uint64_t brutePairs, gridCount;
+    double bruteUs = timeUs([&] { return bruteForce(pts); }, frames, brutePairs);
+    double gridUs = timeUs([&] { return gridPairs(pts); }, frames, gridCount);
+
+    printf("%6u %10llu %12.1f %12.1f %7.1fx%s\n", n, (unsigned long long)brutePairs, bruteUs, gridUs,
+           bruteUs / gridUs, brutePairs == gridCount ? "" : "  MISMATCH");
+    if (brutePairs != gridCount) ok = false;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// Host-side check of the fixed-point Mahony filter used for tilt control.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. bench/mahony_bench.cpp mahony.cpp -o bench/mahony_bench && bench/mahony_bench [seconds] [seed]
+//
+// Synthesizes a device being waved around (smooth random rotation rates,
+// gyro bias and noise, accelerometer noise and hand jolts), runs the
+// fixed-point filter and a float Mahony with the same gains over the same
+// samples, and reports the gravity error of each against the true attitude
+// plus the cost of one fixed-point update.
+
+#include "mahony.h"
+#include "tilt.h"
+#include "prng.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const float HZ = TILT_HZ;
+static const float KP = TILT_KP;
+static const float KP_WARM = TILT_KP_WARM;
+static const float KI = TILT_KI;
+static const int SUBSTEPS = 8;
+
+struct FloatMahony {
+  float q[4] = { 1, 0, 0, 0 };
+  float bias[3] = { 0, 0, 0 };
+  int samples = 0;
+
+  void gravity(float v[3]) const {
+    v[0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+    v[1] = 2 * (q[0] * q[1] + q[2] * q[3]);
+    v[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+  }
+
+  void update(const float g[3], const float a[3]) {
+    float halfDt = 0.5f / HZ;
+    float h[3] = { g[0] * halfDt, g[1] * halfDt, g[2] * halfDt };
+    float n = sqrtf(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+    if (n > 0) {
+      float u[3] = { a[0] / n, a[1] / n, a[2] / n };
+      float v[3];
+      gravity(v);
+      float e[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+      float kp = (samples < MAHONY_WARMUP) ? KP_WARM : KP;
+      for (int i = 0; i < 3; i++) {
+        bias[i] += KI * 2 * halfDt * halfDt * e[i];
+        h[i] += kp * halfDt * e[i] + bias[i];
+      }
+    }
+    if (samples < MAHONY_WARMUP) samples++;
+    float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    q[0] = q0 - q1 * h[0] - q2 * h[1] - q3 * h[2];
+    q[1] = q1 + q0 * h[0] + q2 * h[2] - q3 * h[1];
+    q[2] = q2 + q0 * h[1] - q1 * h[2] + q3 * h[0];
+    q[3] = q3 + q0 * h[2] + q1 * h[1] - q2 * h[0];
+    float m = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) q[i] /= m;
+  }
+};
+
+struct Sample {
+  float gyro[3];
+  float accel[3];
+  float up[3];
+};
+
+static float gauss(PrngState& rng) {
+  float u1 = (prngStateNext(rng) + 1.0f) / 4294967296.0f;
+  float u2 = prngStateNext(rng) / 4294967296.0f;
+  return sqrtf(-2 * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+static std::vector<Sample> synthesize(uint32_t n, uint32_t seed) {
+  PrngState rng;
+  prngStateSeed(rng, seed, 0);
+  std::vector<Sample> out(n);
+  FloatMahony truth;
+  truth.q[0] = 0.9f; truth.q[1] = 0.3f; truth.q[2] = -0.2f; truth.q[3] = 0.1f;
+  float m = sqrtf(0.81f + 0.09f + 0.04f + 0.01f);
+  for (float& c : truth.q) c /= m;
+
+  float w[3] = { 0, 0, 0 };
+  float target[3] = { 0, 0, 0 };
+  float gyroBias[3] = { 0.02f, -0.015f, 0.01f };
+  for (uint32_t i = 0; i < n; i++) {
+    if (i % 100 == 0) {
+      for (float& t : target) t = gauss(rng) * 2.5f;
+    }
+    for (int k = 0; k < 3; k++) w[k] += (target[k] - w[k]) * 0.05f;
+
+    float dt = 1.0f / HZ / SUBSTEPS;
+    for (int s = 0; s < SUBSTEPS; s++) {
+      float* q = truth.q;
+      float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+      float hx = w[0] * dt / 2, hy = w[1] * dt / 2, hz = w[2] * dt / 2;
+      q[0] = q0 - q1 * hx - q2 * hy - q3 * hz;
+      q[1] = q1 + q0 * hx + q2 * hz - q3 * hy;
+      q[2] = q2 + q0 * hy - q1 * hz + q3 * hx;
+      q[3] = q3 + q0 * hz + q1 * hy - q2 * hx;
+      float mm = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+      for (int c = 0; c < 4; c++) q[c] /= mm;
+    }
+
+    Sample& smp = out[i];
+    truth.gravity(smp.up);
+    float jolt = (prngStateNext(rng) % 50 == 0) ? 0.4f : 0.0f;
+    for (int k = 0; k < 3; k++) {
+      smp.gyro[k] = w[k] + gyroBias[k] + gauss(rng) * 0.01f;
+      smp.accel[k] = smp.up[k] + gauss(rng) * 0.02f + jolt * gauss(rng);
+    }
+  }
+  return out;
+}
+
+static float angleDeg(const float a[3], const float b[3]) {
+  float d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  float na = sqrtf(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+  float nb = sqrtf(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+  float c = d / (na * nb);
+  if (c > 1) c = 1;
+  if (c < -1) c = -1;
+  return acosf(c) * 57.29578f;
+}
+
+static int32_t toQ16(float v) {
+  return (int32_t)lroundf(v * (1 << MAHONY_IN_Q));
+}
+
+int main(int argc, char** argv) {
+  uint32_t seconds = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 600;
+  uint32_t seed = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 0x4D41484Fu;
+  uint32_t n = (uint32_t)(seconds * HZ);
+  std::vector<Sample> samples = synthesize(n, seed);
+
+  std::vector<int32_t> gyro(n * 3), accel(n * 3);
+  for (uint32_t i = 0; i < n; i++) {
+    for (int k = 0; k < 3; k++) {
+      gyro[i * 3 + k] = toQ16(samples[i].gyro[k]);
+      accel[i * 3 + k] = toQ16(samples[i].accel[k]);
+    }
+  }
+
+  MahonyState fixed;
+  mahonyInit(fixed, HZ, KP, KP_WARM, KI);
+  FloatMahony ref;
+  double fixSum = 0, refSum = 0, diffSum = 0;
+  float fixMax = 0, refMax = 0, diffMax = 0;
+  uint32_t settled = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    mahonyUpdate(fixed, &gyro[i * 3], &accel[i * 3]);
+    ref.update(samples[i].gyro, samples[i].accel);
+    if (i < 2 * MAHONY_WARMUP) continue;
+
+    int32_t v[3];
+    mahonyGravity(fixed, v);
+    float fv[3] = { v[0] / (float)MAHONY_ONE, v[1] / (float)MAHONY_ONE, v[2] / (float)MAHONY_ONE };
+    float rv[3];
+    ref.gravity(rv);
+    float ef = angleDeg(fv, samples[i].up);
+    float er = angleDeg(rv, samples[i].up);
+    float ed = angleDeg(fv, rv);
+    fixSum += ef;
+    refSum += er;
+    diffSum += ed;
+    if (ef > fixMax) fixMax = ef;
+    if (er > refMax) refMax = er;
+    if (ed > diffMax) diffMax = ed;
+    settled++;
+  }
+
+  printf("%u samples at %.0f Hz  kp %.2f  ki %.3f  seed 0x%08X\n\n", n, HZ, KP, KI, seed);
+  printf("%-18s %10s %10s\n", "gravity error", "mean deg", "max deg");
+  printf("%-18s %10.3f %10.3f\n", "fixed vs truth", fixSum / settled, fixMax);
+  printf("%-18s %10.3f %10.3f\n", "float vs truth", refSum / settled, refMax);
+  printf("%-18s %10.4f %10.4f\n", "fixed vs float", diffSum / settled, diffMax);
+
+  MahonyState timed;
+  mahonyInit(timed, HZ, KP, KP_WARM, KI);
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++) mahonyUpdate(timed, &gyro[i * 3], &accel[i * 3]);
+  auto t1 = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+  volatile int32_t sink = timed.q[0];
+  (void)sink;
+  printf("\nfixed update %.1f ns\n", ns);
+  return (diffSum / settled < 0.5) ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+// Host-side check of the match rules: counters, commander damage and replay.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. -Ibench bench/match_check.cpp game.cpp counters.cpp turntimer.cpp -o bench/match_check && bench/match_check
+//
+// Every case folds events through the live state and again through
+// gameReplay, so the two paths must agree as well as be correct.
+
+#include "game.h"
+#include "counters.h"
+#include "prng.h"
+#include <cstdio>
+
+// prng.cpp seeds from the ESP32 hardware RNG; these cases roll no dice.
+static PrngState hostRng = { 1, 1 };
+uint32_t prngBelow(PrngStream, uint32_t bound) { return prngStateBelow(hostRng, bound); }
+int32_t prngRange(PrngStream, int32_t lo, int32_t hi) {
+  return lo + (int32_t)prngStateBelow(hostRng, (uint32_t)(hi - lo + 1));
+}
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+  printf("%-52s %s\n", what, ok ? "ok" : "FAIL");
+  if (!ok) failures++;
+}
+
+static bool replayMatches(const GameState& gs, uint8_t player, uint8_t slot) {
+  GameState replayed;
+  gameReplay(replayed, gameEventCount());
+  return replayed.players.life[player] == gs.players.life[player] &&
+         counterGet(replayed.counters, player, slot) == counterGet(gs.counters, player, slot);
+}
+
+int main() {
+  const ThemeId themes[MAX_PLAYERS] = {};
+  GameState gs;
+  const uint8_t cmdr = COUNTER_CMDR_BASE + 1;
+
+  gameInit(gs, 40, 2, themes);
+  gameAddCounter(gs, 0, cmdr, -1);
+  expect(counterGet(gs.counters, 0, cmdr) == 0, "cmdr damage below zero clamps to zero");
+  expect(gs.players.life[0] == 40, "clamped cmdr damage leaves life unchanged");
+  expect(replayMatches(gs, 0, cmdr), "replay agrees after clamp at zero");
+
+  gameAddCounter(gs, 0, cmdr, 5);
+  gameAddCounter(gs, 0, cmdr, -2);
+  expect(counterGet(gs.counters, 0, cmdr) == 3, "cmdr damage accumulates");
+  expect(gs.players.life[0] == 37, "life follows applied cmdr damage");
+  expect(replayMatches(gs, 0, cmdr), "replay agrees after damage");
+
+  gameInit(gs, 20, 2, themes);
+  gameAddLife(gs, 1, LIFE_CEIL - 20);
+  gameAddCounter(gs, 1, COUNTER_CMDR_BASE, COUNTER_MAX);
+  gameAddCounter(gs, 1, COUNTER_CMDR_BASE, 1);
+  expect(counterGet(gs.counters, 1, COUNTER_CMDR_BASE) == COUNTER_MAX, "cmdr damage clamps at COUNTER_MAX");
+  expect(gs.players.life[1] == LIFE_CEIL - COUNTER_MAX, "life ignores damage past COUNTER_MAX");
+  expect(replayMatches(gs, 1, COUNTER_CMDR_BASE), "replay agrees after clamp at max");
+
+  printf("\n%s\n", failures ? "FAILED" : "all checks passed");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+// Records minigame runs and replays them as deterministic benchmarks.
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -DMG_HEADLESS -I. -Ibench bench/mg_replay.cpp minigames.cpp mgrecord.cpp -o bench/mg_replay
+//
+//   bench/mg_replay record <game 0-3> <seed> <file>   play with random input, save the run
+//   bench/mg_replay play <file> [repeats]            replay, verify and time it
+//
+// Files hold the same blob the device stores for its ghosts, so a run
+// dumped from the device replays here too. Replaying must end on the same
+// tick with the same score, otherwise the game logic changed behaviour.
+
+#include "minigames.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using Clock = std::chrono::steady_clock;
+
+static const uint32_t MAX_TICKS = MG_TICK_HZ * 3600;
+
+static MgRecording rec;
+
+static int record(uint8_t g, uint32_t seed, const char* path) {
+  const MiniGame& game = MINIGAMES[g];
+  MgContext ctx = {};
+  MgRecorder recorder;
+  PrngState inputRng;
+  prngStateSeed(inputRng, seed, 100 + g);
+  JoystickState js = {};
+
+  mgStart(game, ctx, seed);
+  mgRecBegin(recorder, rec, g, seed);
+  while (game.alive() && ctx.tick < MAX_TICKS) {
+    if (ctx.tick % (MG_TICK_HZ / 4) == 0) {
+      js.ax = (int8_t)((int32_t)prngStateBelow(inputRng, 2 * JOYSTICK_AXIS_STEPS + 1) - JOYSTICK_AXIS_STEPS);
+      js.ay = (int8_t)((int32_t)prngStateBelow(inputRng, 2 * JOYSTICK_AXIS_STEPS + 1) - JOYSTICK_AXIS_STEPS);
+    }
+    js.button = prngStateBelow(inputRng, MG_TICK_HZ) == 0;
+    mgRecPush(recorder, js);
+    mgStep(game, ctx, js);
+  }
+  if (!mgRecEnd(recorder, game.score())) {
+    fprintf(stderr, "run does not fit in %d bytes\n", MG_REC_BYTES);
+    return 1;
+  }
+
+  FILE* f = fopen(path, "wb");
+  if (!f || fwrite(&rec, 1, MG_REC_HEADER_BYTES + rec.length, f) != MG_REC_HEADER_BYTES + rec.length) {
+    perror(path);
+    return 1;
+  }
+  fclose(f);
+  printf("%s: %u ticks, score %u, %u bytes of input\n", game.name, rec.ticks, rec.score, rec.length);
+  return 0;
+}
+
+static int play(const char* path, uint32_t repeats) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return 1;
+  }
+  size_t len = fread(&rec, 1, sizeof(rec), f);
+  fclose(f);
+  if (!mgRecValid(rec, len) || rec.game >= MINIGAME_COUNT) {
+    fprintf(stderr, "%s: not a minigame recording\n", path);
+    return 1;
+  }
+
+  const MiniGame& game = MINIGAMES[rec.game];
+  double worstUs = 0;
+  double totalUs = 0;
+  bool ok = true;
+
+  for (uint32_t r = 0; r < repeats; r++) {
+    MgContext ctx = {};
+    MgPlayer player;
+    JoystickState js;
+    mgStart(game, ctx, rec.seed);
+    mgPlayBegin(player, rec);
+
+    Clock::time_point start = Clock::now();
+    while (game.alive() && mgPlayNext(player, js)) {
+      Clock::time_point t0 = Clock::now();
+      mgStep(game, ctx, js);
+      double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+      if (us > worstUs) worstUs = us;
+    }
+    totalUs += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    if (ctx.tick != rec.ticks || game.score() != rec.score) {
+      printf("MISMATCH: ended at tick %u with score %u, recorded %u and %u\n", ctx.tick, game.score(), rec.ticks,
+             rec.score);
+      ok = false;
+      break;
+    }
+  }
+
+  printf("%s: %u ticks x %u  score %u  mean %.3f us  worst %.1f us  %s\n", game.name, rec.ticks, repeats, rec.score,
+         totalUs / ((double)rec.ticks * repeats), worstUs, ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  if (argc == 5 && strcmp(argv[1], "record") == 0) {
+    uint8_t g = (uint8_t)atoi(argv[2]);
+    if (g >= MINIGAME_COUNT) {
+      fprintf(stderr, "game must be 0-%d\n", MINIGAME_COUNT - 1);
+      return 1;
+    }
+    return record(g, (uint32_t)strtoul(argv[3], nullptr, 0), argv[4]);
+  }
+  if ((argc == 3 || argc == 4) && strcmp(argv[1], "play") == 0) {
+    return play(argv[2], (argc == 4) ? (uint32_t)strtoul(argv[3], nullptr, 10) : 100);
+  }
+  fprintf(stderr, "usage: %s record <game> <seed> <file> | play <file> [repeats]\n", argv[0]);
+  return 1;
+}
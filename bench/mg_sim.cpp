@@ -0,0 +1,106 @@
+// Headless minigame runner: plays every registered minigame at full speed
+// on the host and reports tick throughput and worst-case tick time.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -DMG_HEADLESS -I. -Ibench bench/mg_sim.cpp minigames.cpp mgbot.cpp -o bench/mg_sim
+//   bench/mg_sim [ticks] [seed] [random|sweep|bot|stress]
+//
+// Each game is played for the given number of ticks (default ten minutes
+// of game time) and restarted with the next seed whenever it ends. Input
+// is either a random walk that changes every quarter second, a scripted
+// sweep through all eight directions with a button press per turn, or the
+// autoplay bots from mgbot.cpp. The bots survive long enough to reach the
+// top speed and spawn rate, so "bot" with a large tick count is the host
+// soak test. "stress" is "bot" with the entity pools refilled to capacity
+// before every tick, as the device's stress mode does, so the timings are
+// for full pools.
+
+#include "minigames.h"
+#include "mgbot.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using Clock = std::chrono::steady_clock;
+
+static const int8_t SWEEP[8][2] = {
+  { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 },
+  { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 }
+};
+
+enum InputMode { INPUT_RANDOM, INPUT_SWEEP, INPUT_BOT, INPUT_STRESS };
+
+static const char* const INPUT_NAMES[] = { "random", "sweep", "bot", "stress" };
+
+static void nextInput(JoystickState& js, PrngState& rng, uint32_t tick, uint8_t game, InputMode mode) {
+  js.connected = true;
+  if (mode == INPUT_BOT || mode == INPUT_STRESS) {
+    js = mgBotInput(game);
+    return;
+  }
+  if (mode == INPUT_SWEEP) {
+    uint32_t step = tick / (MG_TICK_HZ / 2);
+    js.ax = SWEEP[step % 8][0] * JOYSTICK_AXIS_STEPS;
+    js.ay = SWEEP[step % 8][1] * JOYSTICK_AXIS_STEPS;
+    js.button = (tick % (MG_TICK_HZ * 4)) < 2;
+    return;
+  }
+  if (tick % (MG_TICK_HZ / 4) == 0) {
+    js.ax = (int8_t)((int32_t)prngStateBelow(rng, 2 * JOYSTICK_AXIS_STEPS + 1) - JOYSTICK_AXIS_STEPS);
+    js.ay = (int8_t)((int32_t)prngStateBelow(rng, 2 * JOYSTICK_AXIS_STEPS + 1) - JOYSTICK_AXIS_STEPS);
+  }
+  js.button = prngStateBelow(rng, MG_TICK_HZ) == 0;
+}
+
+int main(int argc, char** argv) {
+  uint32_t ticks = (argc > 1) ? (uint32_t)strtoul(argv[1], nullptr, 10) : MG_TICK_HZ * 600;
+  uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], nullptr, 0) : 0xC0FFEEu;
+  InputMode mode = INPUT_RANDOM;
+  for (uint8_t m = 0; argc > 3 && m <= INPUT_STRESS; m++) {
+    if (strcmp(argv[3], INPUT_NAMES[m]) == 0) mode = (InputMode)m;
+  }
+
+  printf("ticks per game: %u  seed: 0x%08X  input: %s\n\n", ticks, seed, INPUT_NAMES[mode]);
+  printf("%-14s %8s %10s %10s %12s %10s %10s\n", "game", "games", "best", "longest s", "ticks/s", "mean us",
+         "worst us");
+
+  for (uint8_t g = 0; g < MINIGAME_COUNT; g++) {
+    const MiniGame& game = MINIGAMES[g];
+    MgContext ctx = {};
+    PrngState inputRng;
+    prngStateSeed(inputRng, seed, 100 + g);
+    JoystickState js = {};
+
+    uint32_t games = 1;
+    uint16_t best = 0;
+    uint32_t longest = 0;
+    uint16_t maxEntities = 0;
+    double worstUs = 0;
+    mgStart(game, ctx, seed);
+
+    Clock::time_point start = Clock::now();
+    for (uint32_t t = 0; t < ticks; t++) {
+      if (!game.alive()) {
+        if (game.score() > best) best = game.score();
+        if (ctx.tick > longest) longest = ctx.tick;
+        mgStart(game, ctx, seed + games++);
+      }
+      nextInput(js, inputRng, ctx.tick, g, mode);
+      if (mode == INPUT_STRESS && game.fill) game.fill(ctx);
+
+      Clock::time_point t0 = Clock::now();
+      mgStep(game, ctx, js);
+      double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+      if (us > worstUs) worstUs = us;
+      if (game.entities() > maxEntities) maxEntities = game.entities();
+    }
+    double totalUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    if (game.score() > best) best = game.score();
+    if (ctx.tick > longest) longest = ctx.tick;
+
+    printf("%-14s %8u %10u %10u %12.0f %10.3f %10.1f  max entities %u\n", game.name, games, best,
+           longest / MG_TICK_HZ, ticks / (totalUs / 1e6), totalUs / ticks, worstUs, maxEntities);
+  }
+  return 0;
+}
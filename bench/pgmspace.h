@@ -0,0 +1,12 @@
+#ifndef PGMSPACE_H
+#define PGMSPACE_H
+
+// Host stand-in for the ESP32 <pgmspace.h>: flash and RAM are one address
+// space on the host, so PROGMEM reads are plain loads.
+#include <stdint.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+
+#endif
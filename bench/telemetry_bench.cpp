@@ -0,0 +1,68 @@
+// Host-side check of the telemetry ring.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. bench/telemetry_bench.cpp telemetry.cpp -o bench/telemetry_bench && bench/telemetry_bench [hours] [interval_s]
+//
+// Feeds a simulated event day (battery drain with ADC noise, temperature
+// drift, heap churn, CPU clock steps) into the ring, checks that min/max
+// columns decoded from it match the raw samples still covered, and
+// reports bytes per sample and how many hours the ring holds.
+
+#include "telemetry.h"
+#include "prng.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Sample {
+  int16_t v[TELE_CHANNELS];
+};
+
+int main(int argc, char** argv) {
+  float hours = (argc > 1) ? atof(argv[1]) : 16;
+  uint16_t interval = (argc > 2) ? atoi(argv[2]) : 10;
+  uint32_t n = (uint32_t)(hours * 3600 / interval);
+
+  PrngState rng;
+  prngStateSeed(rng, 0x7E1E, 0);
+  std::vector<Sample> raw(n);
+  telemetryReset();
+  for (uint32_t i = 0; i < n; i++) {
+    float t = (float)i / n;
+    Sample& s = raw[i];
+    s.v[TELE_BATT_MV] = (int16_t)(4150 - 950 * t + (int)prngStateBelow(rng, 21) - 10);
+    s.v[TELE_BATT_PCT] = (int16_t)(100 - 100 * t);
+    s.v[TELE_TEMP_DC] = (int16_t)(380 + 60 * t + (int)prngStateBelow(rng, 5) - 2);
+    s.v[TELE_HEAP] = (int16_t)(2800 + (prngStateBelow(rng, 8) == 0 ? (int)prngStateBelow(rng, 200) : 0));
+    s.v[TELE_CPU_MHZ] = (t > 0.8f) ? 80 : 240;
+    telemetryAppend(s.v, interval);
+  }
+
+  uint32_t first = telemetryFirstSeq();
+  uint32_t end = telemetryEndSeq();
+  uint32_t kept = end - first;
+  uint32_t bad = 0;
+  for (uint16_t spp : { 1, 7, 64 }) {
+    uint32_t firstCol = (first + spp - 1) / spp;
+    uint32_t cols = end / spp - firstCol;
+    std::vector<int16_t> lo(cols), hi(cols);
+    for (uint8_t ch = 0; ch < TELE_CHANNELS; ch++) {
+      telemetryColumns(ch, spp, firstCol, cols, lo.data(), hi.data());
+      for (uint32_t c = 0; c < cols; c++) {
+        int16_t mn = INT16_MAX, mx = INT16_MIN;
+        for (uint32_t k = 0; k < spp; k++) {
+          int16_t v = raw[(firstCol + c) * spp + k].v[ch];
+          if (v < mn) mn = v;
+          if (v > mx) mx = v;
+        }
+        if (lo[c] != mn || hi[c] != mx) bad++;
+      }
+    }
+  }
+
+  uint32_t ringBytes = TELEMETRY_BLOCKS * TELEMETRY_BLOCK_BYTES;
+  printf("%u samples every %u s, ring %u bytes\n", n, interval, ringBytes);
+  printf("kept %u samples (%.1f h), %.2f bytes/sample, mismatched columns %u\n",
+         kept, telemetrySpanSeconds() / 3600.0f, (float)ringBytes / kept, bad);
+  return bad ? 1 : 0;
+}
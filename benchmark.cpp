@@ -0,0 +1,210 @@
+#include "benchmark.h"
+#include "config.h"
+#include "display.h"
+#include "joystick.h"
+#include "prng.h"
+#include <M5Unified.h>
+#include <Preferences.h>
+
+struct BenchmarkInfo {
+  const char* name;
+  const char* unit;
+};
+
+static const BenchmarkInfo INFO[BENCH_COUNT] = {
+  { "fill_push",    "us/frame" },
+  { "text_size1",   "us/str"   },
+  { "text_size2",   "us/str"   },
+  { "text_size4",   "us/str"   },
+  { "primitives",   "us/shape" },
+  { "push_sprite",  "KB/s"     },
+  { "imu_read",     "us"       },
+  { "joystick_i2c", "us"       },
+  { "nvs_read",     "us"       },
+  { "nvs_write",    "us"       },
+  { "prng",         "M/s"      }
+};
+
+static BenchmarkResult results[BENCH_COUNT];
+static uint8_t next = BENCH_COUNT;
+
+static const char BENCH_TEXT[] = "Life 20 Poison 3 Cmd";
+
+static float fillPush() {
+  M5Canvas& spr = displayGetSprite();
+  unsigned long t0 = micros();
+  for (uint16_t i = 0; i < BENCH_FRAMES; i++) {
+    spr.fillSprite((i & 1) ? COLOR_BG : COLOR_DIM);
+    spr.pushSprite(0, 0);
+  }
+  M5.Display.waitDMA();
+  return (float)(micros() - t0) / BENCH_FRAMES;
+}
+
+static float textSize(uint8_t size) {
+  M5Canvas& spr = displayGetSprite();
+  spr.fillSprite(COLOR_BG);
+  spr.setTextSize(size);
+  spr.setTextColor(COLOR_TEXT, COLOR_BG);
+  unsigned long t0 = micros();
+  for (uint16_t i = 0; i < BENCH_TEXT_REPS; i++) {
+    spr.setCursor(0, (i * 8) % SCREEN_H);
+    spr.print(BENCH_TEXT);
+  }
+  unsigned long us = micros() - t0;
+  spr.pushSprite(0, 0);
+  return (float)us / BENCH_TEXT_REPS;
+}
+
+// Lines, rects, circles and triangles in equal measure, as the menus and
+// minigames use them.
+static float primitives() {
+  M5Canvas& spr = displayGetSprite();
+  spr.fillSprite(COLOR_BG);
+  unsigned long t0 = micros();
+  for (uint16_t i = 0; i < BENCH_PRIM_REPS; i++) {
+    int x = (i * 37) % (SCREEN_W - 40);
+    int y = (i * 23) % (SCREEN_H - 40);
+    uint16_t c = i * 0x0841;
+    spr.drawLine(x, y, x + 39, y + 27, c);
+    spr.fillRect(x, y, 24, 16, c);
+    spr.fillCircle(x + 20, y + 20, 12, c);
+    spr.fillTriangle(x, y + 39, x + 20, y, x + 39, y + 39, c);
+  }
+  unsigned long us = micros() - t0;
+  spr.pushSprite(0, 0);
+  return (float)us / (BENCH_PRIM_REPS * 4);
+}
+
+static float pushSprite() {
+  M5Canvas& spr = displayGetSprite();
+  unsigned long t0 = micros();
+  for (uint16_t i = 0; i < BENCH_FRAMES; i++) spr.pushSprite(0, 0);
+  M5.Display.waitDMA();
+  unsigned long us = micros() - t0;
+  return (float)SCREEN_W * SCREEN_H * 2 * BENCH_FRAMES / 1024 / (us / 1e6f);
+}
+
+static bool imuRead(float& value) {
+  if (!M5.Imu.isEnabled()) return false;
+  m5::imu_data_t d;
+  unsigned long t0 = micros();
+  for (uint16_t i = 0; i < BENCH_IMU_REPS; i++) {
+    M5.Imu.update();
+    M5.Imu.getImuData(&d);
+  }
+  value = (float)(micros() - t0) / BENCH_IMU_REPS;
+  return true;
+}
+
+// The poll task owns the HAT bus, so this averages the round trips it
+// times over a window instead of issuing its own.
+static bool joystickI2C(float& value, uint32_t& reps) {
+  JoystickState js;
+  joystickRead(js);
+  if (!js.connected) return false;
+  JoystickStats a = joystickGetStats();
+  delay(BENCH_JOYSTICK_MS);
+  JoystickStats b = joystickGetStats();
+  reps = b.samples - a.samples;
+  if (reps == 0) return false;
+  value = (float)(b.busUsTotal - a.busUsTotal) / reps;
+  return true;
+}
+
+// A namespace of its own, emptied afterwards, so settings are never touched.
+static float nvs(bool write) {
+  Preferences p;
+  p.begin(BENCH_NVS_NAMESPACE, false);
+  p.putUInt("v", 0);
+  unsigned long t0 = micros();
+  uint32_t sink = 0;
+  for (uint16_t i = 0; i < BENCH_NVS_REPS; i++) {
+    if (write) p.putUInt("v", i + 1);
+    else sink += p.getUInt("v", 0);
+  }
+  unsigned long us = micros() - t0;
+  p.remove("v");
+  p.end();
+  (void)sink;
+  return (float)us / BENCH_NVS_REPS;
+}
+
+static float prng() {
+  PrngState st;
+  prngStateSeed(st, 0xBE7C4, 0);
+  volatile uint32_t sink = 0;
+  uint32_t acc = 0;
+  unsigned long t0 = micros();
+  for (uint32_t i = 0; i < BENCH_PRNG_REPS; i++) acc += prngStateNext(st);
+  unsigned long us = micros() - t0;
+  sink = acc;
+  (void)sink;
+  return (float)BENCH_PRNG_REPS / us;
+}
+
+void benchmarkBegin() {
+  memset(results, 0, sizeof(results));
+  next = 0;
+}
+
+bool benchmarkStep() {
+  if (next >= BENCH_COUNT) return false;
+  BenchmarkResult& r = results[next];
+  r.ok = true;
+  switch ((BenchmarkId)next) {
+    case BENCH_FILL_PUSH:    r.value = fillPush();   r.reps = BENCH_FRAMES;    break;
+    case BENCH_TEXT_1:       r.value = textSize(1);  r.reps = BENCH_TEXT_REPS; break;
+    case BENCH_TEXT_2:       r.value = textSize(2);  r.reps = BENCH_TEXT_REPS; break;
+    case BENCH_TEXT_4:       r.value = textSize(4);  r.reps = BENCH_TEXT_REPS; break;
+    case BENCH_PRIMITIVES:   r.value = primitives(); r.reps = BENCH_PRIM_REPS * 4; break;
+    case BENCH_PUSH_SPRITE:  r.value = pushSprite(); r.reps = BENCH_FRAMES;    break;
+    case BENCH_IMU_READ:     r.ok = imuRead(r.value); r.reps = BENCH_IMU_REPS; break;
+    case BENCH_JOYSTICK_I2C: r.ok = joystickI2C(r.value, r.reps);              break;
+    case BENCH_NVS_READ:     r.value = nvs(false);   r.reps = BENCH_NVS_REPS;  break;
+    case BENCH_NVS_WRITE:    r.value = nvs(true);    r.reps = BENCH_NVS_REPS;  break;
+    case BENCH_PRNG:         r.value = prng();       r.reps = BENCH_PRNG_REPS; break;
+    default: break;
+  }
+  next++;
+  return true;
+}
+
+bool benchmarkRunning() {
+  return next < BENCH_COUNT;
+}
+
+uint8_t benchmarkNext() {
+  return next;
+}
+
+const BenchmarkResult* benchmarkResults() {
+  return results;
+}
+
+const char* benchmarkName(uint8_t id) {
+  return (id < BENCH_COUNT) ? INFO[id].name : "";
+}
+
+const char* benchmarkUnit(uint8_t id) {
+  return (id < BENCH_COUNT) ? INFO[id].unit : "";
+}
+
+void benchmarkPrint(Print& out) {
+  uint64_t mac = ESP.getEfuseMac();
+  char board[13];
+  snprintf(board, sizeof(board), "%04X%08lX", (unsigned)(mac >> 32), (unsigned long)(mac & 0xFFFFFFFF));
+  out.println("bench,version,build,board,cpu_mhz,metric,value,unit,reps");
+  for (uint8_t i = 0; i < BENCH_COUNT; i++) {
+    const BenchmarkResult& r = results[i];
+    char line[128];
+    if (r.ok) {
+      snprintf(line, sizeof(line), "bench,%s,%s %s,%s,%lu,%s,%.3f,%s,%lu", APP_VERSION, __DATE__, __TIME__, board,
+               (unsigned long)getCpuFrequencyMhz(), INFO[i].name, r.value, INFO[i].unit, (unsigned long)r.reps);
+    } else {
+      snprintf(line, sizeof(line), "bench,%s,%s %s,%s,%lu,%s,,%s,0", APP_VERSION, __DATE__, __TIME__, board,
+               (unsigned long)getCpuFrequencyMhz(), INFO[i].name, INFO[i].unit);
+    }
+    out.println(line);
+  }
+}
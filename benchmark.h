@@ -0,0 +1,51 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+
+// On-device benchmark suite (Diagnostics > Tests > Benchmark). Each step
+// runs one benchmark to completion so the caller can redraw progress in
+// between; the display ones draw over the screen while they run.
+enum BenchmarkId : uint8_t {
+  BENCH_FILL_PUSH,
+  BENCH_TEXT_1,
+  BENCH_TEXT_2,
+  BENCH_TEXT_4,
+  BENCH_PRIMITIVES,
+  BENCH_PUSH_SPRITE,
+  BENCH_IMU_READ,
+  BENCH_JOYSTICK_I2C,
+  BENCH_NVS_READ,
+  BENCH_NVS_WRITE,
+  BENCH_PRNG,
+  BENCH_COUNT
+};
+
+#define BENCH_FRAMES        60
+#define BENCH_TEXT_REPS     200
+#define BENCH_PRIM_REPS     500
+#define BENCH_IMU_REPS      200
+#define BENCH_JOYSTICK_MS   500
+#define BENCH_NVS_REPS      20
+#define BENCH_PRNG_REPS     1000000
+#define BENCH_NVS_NAMESPACE "mtg-bench"
+
+struct BenchmarkResult {
+  float value;
+  uint32_t reps;
+  bool ok;
+};
+
+void benchmarkBegin();
+// Runs the next benchmark. Returns false once all of them have run.
+bool benchmarkStep();
+bool benchmarkRunning();
+uint8_t benchmarkNext();
+const BenchmarkResult* benchmarkResults();
+const char* benchmarkName(uint8_t id);
+const char* benchmarkUnit(uint8_t id);
+// One CSV line per metric, prefixed with the build and the board MAC so
+// logs from several sticks and firmwares can be concatenated and diffed.
+void benchmarkPrint(Print& out);
+
+#endif
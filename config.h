@@ -7,6 +7,7 @@
 // === App Info ===
 #define APP_VERSION "v1.0.0"
 #define APP_DEVICE "M5StickC PLUS 2"
+#define SERIAL_BAUD 115200
 
 // === Screen ===
 #define SCREEN_W 240
@@ -17,10 +18,25 @@
 #define LIFE_STANDARD  20
 #define LIFE_COMMANDER 40
 #define LIFE_MIN       1
-#define LIFE_MAX       255
+#define LIFE_MAX       999
+#define LIFE_FLOOR     -999
+#define LIFE_CEIL      9999
+#define COUNTER_MAX    9999
+#define QUICK_ENTRY_DIGITS 3
+#define MATCH_LOG_SIZE          1024
+#define MATCH_SNAPSHOT_INTERVAL 64
+#define TURN_LOG_BYTES          512
+#define CHESS_CLOCK_BANK_MS     (15UL * 60UL * 1000UL)
 #define LIFE_DEFAULT   30
-#define MAX_PLAYERS    2
+#define MIN_PLAYERS    2
+#define MAX_PLAYERS    6
 #define HISTORY_SIZE   10
+#define POISON_LETHAL       10
+#define CMDR_DAMAGE_LETHAL  21
+
+// === PRNG ===
+// Non-zero pins every random stream to a fixed seed for reproducible runs.
+#define PRNG_FIXED_SEED 0
 
 // === Input Timing (ms) ===
 #define LONG_PRESS_MS     500
@@ -46,16 +62,34 @@ const uint8_t SHUTDOWN_GAME_MIN[] PROGMEM = { 15, 25, 35 };
 #define POWER_SAVE_CPU_MHZ           80
 #define POWER_CHECK_INTERVAL_MS      5000
 
+// === Telemetry ===
+#define TELEMETRY_RATE_COUNT    4
+#define TELEMETRY_RATE_DEFAULT  2
+const uint16_t TELEMETRY_RATE_S[] PROGMEM = { 5, 10, 30, 60 };
+
 // === Audio ===
 #define SPEAKER_VOLUME    120
 #define TONE_LIFE_UP      880
 #define TONE_LIFE_DOWN    220
-#define TONE_DICE_ROLL    1200
-#define TONE_COIN_FLIP    600
 #define TONE_CONFIRM      1047
-#define TONE_DEFEAT       147
 #define TONE_DURATION     80
 
+#define AUDIO_QUEUE_LEN     8
+#define AUDIO_PENDING_MAX   4
+#define AUDIO_TASK_STACK    2048
+#define AUDIO_TASK_PRIORITY 2
+#define AUDIO_TONE_CHANNEL  0
+
+#define MIXER_VOICES        4
+#define MIXER_SAMPLE_RATE   16000
+#define MIXER_BLOCK         256
+#define MIXER_CHANNEL       1
+#define MIXER_QUEUE_LEN     8
+#define MIXER_TASK_STACK    3072
+
+#define DICE_ANIM_FRAMES    8
+#define COIN_ANIM_FRAMES    6
+
 // === Fixed Colors ===
 #define COLOR_BG        0x0000
 #define COLOR_TEXT       0xFFFF
@@ -129,7 +163,17 @@ enum AppState {
   STATE_GAME_MANA_RUNNER,
   STATE_GAME_ARENA,
   STATE_GAME_SNAKE,
-  STATE_GAME_SPELL_DODGE
+  STATE_GAME_SPELL_DODGE,
+  STATE_PLAYER_COUNT_SELECT,
+  STATE_COUNTERS,
+  STATE_QUICK_ENTRY,
+  STATE_MATCH_REPLAY,
+  STATE_TURN_STATS,
+  STATE_MG_INITIALS,
+  STATE_MG_SCORES,
+  STATE_PERF,
+  STATE_BENCHMARK,
+  STATE_TELEMETRY
 };
 
 enum MainMenuOption {
@@ -148,8 +192,11 @@ enum GameModeOption {
 
 enum GameMenuOption {
   GMENU_SWITCH_PLAYER,
+  GMENU_COUNTERS,
+  GMENU_QUICK_ENTRY,
   GMENU_DICE,
   GMENU_COIN,
+  GMENU_TURN_STATS,
   GMENU_SETTINGS,
   GMENU_RESET,
   GMENU_COUNT
@@ -159,6 +206,7 @@ enum SettingsOption {
   SET_BRIGHTNESS,
   SET_VOLUME,
   SET_THEME,
+  SET_TIMER_MODE,
   SET_FACE_DOWN_PAUSE,
   SET_SHUTDOWN_IDLE,
   SET_SHUTDOWN_GAME,
@@ -170,12 +218,14 @@ enum SettingsOption {
 enum TimerMode {
   TIMER_PER_TURN,
   TIMER_PER_MATCH,
+  TIMER_CHESS_CLOCK,
   TIMER_MODE_COUNT
 };
 
 enum DiagnosticsOption {
   DIAG_BATTERY,
   DIAG_SYSTEM,
+  DIAG_PERF,
   DIAG_STATS,
   DIAG_TEMPERATURE,
   DIAG_IMU,
@@ -190,6 +240,8 @@ enum EasterEggsOption {
   EE_ARENA_BATTLE,
   EE_SNAKE,
   EE_SPELL_DODGE,
+  EE_MODE,
+  EE_SCORES,
   EE_BACK,
   EE_COUNT
 };
@@ -199,6 +251,7 @@ enum TestMenuOption {
   TEST_BUTTONS,
   TEST_SCREEN,
   TEST_SPEAKER,
+  TEST_BENCHMARK,
   TEST_BACK,
   TEST_COUNT
 };
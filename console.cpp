@@ -0,0 +1,66 @@
+#include "console.h"
+
+static char line[CONSOLE_LINE_MAX];
+static uint8_t lineLen = 0;
+static bool overflow = false;
+
+static uint8_t split(char* argv[CONSOLE_MAX_ARGS]) {
+  uint8_t argc = 0;
+  char* p = line;
+  while (*p && argc < CONSOLE_MAX_ARGS) {
+    while (*p == ' ' || *p == '\t') *p++ = '\0';
+    if (!*p) break;
+    argv[argc++] = p;
+    while (*p && *p != ' ' && *p != '\t') p++;
+  }
+  return argc;
+}
+
+uint8_t consolePoll(Stream& io, char* argv[CONSOLE_MAX_ARGS]) {
+  for (uint8_t n = 0; n < CONSOLE_POLL_BYTES && io.available() > 0; n++) {
+    char c = (char)io.read();
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (lineLen < CONSOLE_LINE_MAX - 1) line[lineLen++] = c;
+      else overflow = true;
+      continue;
+    }
+
+    line[lineLen] = '\0';
+    lineLen = 0;
+    if (overflow) {
+      overflow = false;
+      io.println("err line too long");
+      continue;
+    }
+    uint8_t argc = split(argv);
+    if (argc > 0) return argc;
+  }
+  return 0;
+}
+
+int16_t consoleLookup(const ConsoleName* table, uint8_t count, const char* name) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (strcmp(table[i].name, name) == 0) return table[i].value;
+  }
+  return -1;
+}
+
+void consoleHex(Print& out, const char* tag, const void* data, size_t len) {
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  const uint8_t* p = (const uint8_t*)data;
+  char chunk[65];
+  out.printf("%s %u ", tag, (unsigned)len);
+  size_t i = 0;
+  while (i < len) {
+    uint8_t n = 0;
+    while (n < 64 && i < len) {
+      chunk[n++] = HEX_DIGITS[p[i] >> 4];
+      chunk[n++] = HEX_DIGITS[p[i] & 15];
+      i++;
+    }
+    chunk[n] = '\0';
+    out.print(chunk);
+  }
+  out.println();
+}
@@ -0,0 +1,28 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <Arduino.h>
+
+// Line-oriented serial console. consolePoll() is called once per loop and
+// reads at most CONSOLE_POLL_BYTES, so an idle port costs one available()
+// call and a flood of input cannot stall a frame. Lines are split in place
+// into at most CONSOLE_MAX_ARGS words; nothing is allocated.
+#define CONSOLE_LINE_MAX    96
+#define CONSOLE_POLL_BYTES  32
+#define CONSOLE_MAX_ARGS    6
+
+struct ConsoleName {
+  const char* name;
+  uint8_t value;
+};
+
+// Returns the word count of a completed line (0 while none is ready).
+// argv points into the console's line buffer and stays valid until the
+// next call. Over-long lines are dropped and reported on io.
+uint8_t consolePoll(Stream& io, char* argv[CONSOLE_MAX_ARGS]);
+// Value for name in table, or -1.
+int16_t consoleLookup(const ConsoleName* table, uint8_t count, const char* name);
+// Prints "<tag> <len> <hex bytes>" on one line.
+void consoleHex(Print& out, const char* tag, const void* data, size_t len);
+
+#endif
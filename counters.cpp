@@ -0,0 +1,56 @@
+#include "counters.h"
+#include "satmath.h"
+#include <Arduino.h>
+
+static const uint8_t COUNTER_LETHAL[COUNTER_KIND_COUNT] PROGMEM = {
+  POISON_LETHAL, 0, 0, 0
+};
+
+static const char* const COUNTER_NAMES[COUNTER_KIND_COUNT] = {
+  "Poison", "Energy", "Experience", "Storm"
+};
+
+static inline int16_t& cell(CounterStore& cs, uint8_t player, uint8_t slot) {
+  return cs.values[player * COUNTER_SLOTS + slot];
+}
+
+void countersClear(CounterStore& cs) {
+  memset(cs.values, 0, sizeof(cs.values));
+}
+
+int16_t counterGet(const CounterStore& cs, uint8_t player, uint8_t slot) {
+  return cs.values[player * COUNTER_SLOTS + slot];
+}
+
+uint8_t counterLethalAt(uint8_t slot) {
+  if (slot >= COUNTER_CMDR_BASE) return CMDR_DAMAGE_LETHAL;
+  return pgm_read_byte(&COUNTER_LETHAL[slot]);
+}
+
+bool counterIsLethal(const CounterStore& cs, uint8_t player, uint8_t slot) {
+  uint8_t limit = counterLethalAt(slot);
+  return limit > 0 && counterGet(cs, player, slot) >= limit;
+}
+
+bool counterAdd(CounterStore& cs, uint8_t player, uint8_t slot, int16_t delta) {
+  int16_t& v = cell(cs, player, slot);
+  v = satAdd<int16_t>(v, delta, 0, COUNTER_MAX);
+  return counterIsLethal(cs, player, slot);
+}
+
+int16_t countersMaxCommander(const CounterStore& cs, uint8_t player, uint8_t playerCount) {
+  int16_t best = 0;
+  for (uint8_t j = 0; j < playerCount; j++) {
+    int16_t v = counterGet(cs, player, COUNTER_CMDR_BASE + j);
+    if (v > best) best = v;
+  }
+  return best;
+}
+
+void counterLabel(uint8_t slot, char* buf, size_t len) {
+  if (slot >= COUNTER_CMDR_BASE) {
+    snprintf(buf, len, "Cmdr from P%d", slot - COUNTER_CMDR_BASE + 1);
+  } else {
+    snprintf(buf, len, "%s", COUNTER_NAMES[slot]);
+  }
+}
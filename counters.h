@@ -0,0 +1,31 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include "config.h"
+#include <stddef.h>
+
+enum CounterKind {
+  COUNTER_POISON,
+  COUNTER_ENERGY,
+  COUNTER_EXPERIENCE,
+  COUNTER_STORM,
+  COUNTER_KIND_COUNT
+};
+
+// Slots COUNTER_CMDR_BASE + j hold commander damage taken from player j.
+#define COUNTER_CMDR_BASE  COUNTER_KIND_COUNT
+#define COUNTER_SLOTS      (COUNTER_KIND_COUNT + MAX_PLAYERS)
+
+struct CounterStore {
+  int16_t values[MAX_PLAYERS * COUNTER_SLOTS];
+};
+
+void countersClear(CounterStore& cs);
+int16_t counterGet(const CounterStore& cs, uint8_t player, uint8_t slot);
+bool counterAdd(CounterStore& cs, uint8_t player, uint8_t slot, int16_t delta);
+bool counterIsLethal(const CounterStore& cs, uint8_t player, uint8_t slot);
+uint8_t counterLethalAt(uint8_t slot);
+int16_t countersMaxCommander(const CounterStore& cs, uint8_t player, uint8_t playerCount);
+void counterLabel(uint8_t slot, char* buf, size_t len);
+
+#endif
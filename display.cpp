@@ -1,11 +1,44 @@
 #include "display.h"
+#include "prng.h"
+#include "turntimer.h"
+#include "mixer.h"
+#include "sprites.h"
+#include "perf.h"
+#include "benchmark.h"
+#include "telemetry.h"
 #include <M5Unified.h>
 
 static M5Canvas sprite(&M5.Display);
 static bool spriteReady = false;
+static bool perfOverlay = false;
+static uint32_t drawCount = 0;
 static ColorTheme currentTheme;
 static const ColorTheme* theme = &currentTheme;
 
+#define GAME_BAR_H 18
+#define PERF_HUD_W 84
+#define PERF_HUD_H 9
+
+struct GameTile {
+  int16_t x, y, w, h;
+  uint8_t labelSize;
+  uint8_t lifeSize;
+};
+
+struct DrawnTile {
+  int16_t life;
+  int16_t poison;
+  int16_t cmdrMax;
+  ThemeId theme;
+  bool active;
+  bool alive;
+};
+
+static GameTile gameTiles[MAX_PLAYERS];
+static uint8_t gameTilesCount = 0;
+static DrawnTile drawnTiles[MAX_PLAYERS];
+static bool gameScreenValid = false;
+
 void displaySetTheme(ThemeId id) {
   if (id < THEME_COUNT) {
     memcpy_P(&currentTheme, &THEMES[id], sizeof(ColorTheme));
@@ -18,10 +51,41 @@ static void beginDraw(uint16_t bgColor = COLOR_BG) {
     spriteReady = true;
   }
   sprite.fillSprite(bgColor);
+  gameScreenValid = false;
+  drawCount++;
+}
+
+// Loops per second and p99 frame time in the top-left corner, painted
+// into the canvas on every push so it rides along with whatever is drawn.
+static void drawPerfOverlay() {
+  const PerfStats& ps = perfGetStats();
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%lu/s p99 %lu.%lu",
+           (unsigned long)ps.loopsPerSec, (unsigned long)(ps.frameP99Us / 1000), (unsigned long)(ps.frameP99Us / 100 % 10));
+  sprite.fillRect(0, 0, PERF_HUD_W, PERF_HUD_H, COLOR_BG);
+  sprite.setTextSize(1);
+  sprite.setTextColor(MTG_GREEN, COLOR_BG);
+  sprite.setCursor(1, 1);
+  sprite.print(buf);
 }
 
 static void endDraw() {
+  if (perfOverlay) drawPerfOverlay();
+  sprite.pushSprite(0, 0);
+  perfCountSpi(SCREEN_W * SCREEN_H * 2);
+}
+
+static void endDrawRect(int x, int y, int w, int h) {
+  M5.Display.setClipRect(x, y, w, h);
   sprite.pushSprite(0, 0);
+  perfCountSpi(w * h * 2);
+  if (perfOverlay) {
+    drawPerfOverlay();
+    M5.Display.setClipRect(0, 0, PERF_HUD_W, PERF_HUD_H);
+    sprite.pushSprite(0, 0);
+    perfCountSpi(PERF_HUD_W * PERF_HUD_H * 2);
+  }
+  M5.Display.clearClipRect();
 }
 
 static void drawCentered(const char* text, int y, uint8_t size, uint16_t color, uint16_t bg = COLOR_BG) {
@@ -135,7 +199,7 @@ void displayGameModeSelect(uint8_t selection) {
   endDraw();
 }
 
-void displayCustomLifeInput(uint8_t life) {
+void displayCustomLifeInput(int16_t life) {
   beginDraw();
   drawCentered("Custom Starting Life", 10, 2, theme->title);
 
@@ -150,7 +214,7 @@ void displayCustomLifeInput(uint8_t life) {
   sprite.setTextSize(1);
   sprite.setTextColor(COLOR_DIM, COLOR_BG);
   sprite.setCursor(40, 90);
-  sprite.print("(Range: 1-255)");
+  sprite.print("(Range: 1-999)");
 
   sprite.setCursor(5, 108);
   sprite.print("[OK] +1  [A] -1");
@@ -160,6 +224,35 @@ void displayCustomLifeInput(uint8_t life) {
   endDraw();
 }
 
+void displayPlayerCountSelect(uint8_t count) {
+  beginDraw();
+  drawCentered("Players", 10, 2, theme->title);
+
+  sprite.setTextSize(4);
+  sprite.setTextColor(theme->accent, COLOR_BG);
+  char buf[8];
+  snprintf(buf, sizeof(buf), "%d", count);
+  int16_t w = sprite.textWidth(buf);
+  sprite.setCursor((SCREEN_W - w) / 2, 45);
+  sprite.print(buf);
+
+  int startX = (SCREEN_W - MAX_PLAYERS * 16) / 2;
+  for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+    int cx = startX + i * 16 + 8;
+    if (i < count) {
+      sprite.fillCircle(cx, 92, 5, theme->accent);
+    } else {
+      sprite.drawCircle(cx, 92, 5, COLOR_DIM);
+    }
+  }
+
+  sprite.setTextSize(1);
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(15, 122);
+  sprite.print("[OK] Next  [A] Change  [B] Back");
+  endDraw();
+}
+
 void displayPlayerThemeSelect(uint8_t playerIdx, ThemeId selectedTheme) {
   beginDraw();
 
@@ -202,59 +295,136 @@ void displayPlayerThemeSelect(uint8_t playerIdx, ThemeId selectedTheme) {
   endDraw();
 }
 
-void displayGame(const GameState& gs, TimerMode timerMode) {
-  beginDraw();
+static void layoutGameTiles(uint8_t count) {
+  if (count == gameTilesCount) return;
+
+  uint8_t cols = (count <= 2) ? 1 : (count <= 4 ? 2 : 3);
+  uint8_t rows = (count + cols - 1) / cols;
+  int tileH = (SCREEN_H - GAME_BAR_H - (rows - 1)) / rows;
+
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t row = i / cols;
+    uint8_t col = i % cols;
+    uint8_t inRow = (row == rows - 1) ? count - row * cols : cols;
+    int tileW = (SCREEN_W - (inRow - 1)) / inRow;
+
+    GameTile& t = gameTiles[i];
+    t.x = col * (tileW + 1);
+    t.y = row * (tileH + 1);
+    t.w = (col == inRow - 1) ? SCREEN_W - t.x : tileW;
+    t.h = tileH;
+    t.labelSize = (cols == 1) ? 2 : 1;
+    t.lifeSize = (tileW >= 119) ? 4 : 3;
+  }
+  gameTilesCount = count;
+}
 
-  int halfH = 58;
-  int timerH = 18;
+static void drawGameTile(const GameState& gs, uint8_t i) {
+  const GameTile& t = gameTiles[i];
+  bool isActive = (i == gs.activePlayer);
+  bool alive = gameIsAlive(gs, i);
 
-  for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
-    int yBase = i * (halfH + 1);
-    bool isActive = (i == gs.activePlayer);
+  ColorTheme playerTheme;
+  memcpy_P(&playerTheme, &THEMES[gs.players.theme[i]], sizeof(ColorTheme));
 
-    ColorTheme playerTheme;
-    memcpy_P(&playerTheme, &THEMES[gs.players[i].theme], sizeof(ColorTheme));
+  sprite.fillRect(t.x, t.y, t.w, t.h, playerTheme.menuBg);
 
-    sprite.fillRect(0, yBase, SCREEN_W, halfH, playerTheme.menuBg);
+  if (isActive && !gs.gameOver) {
+    uint16_t borderColor = playerTheme.activeBar;
+    sprite.fillRect(t.x, t.y, t.w, 3, borderColor);
+    sprite.fillRect(t.x, t.y, 3, t.h, borderColor);
+    sprite.fillRect(t.x + t.w - 3, t.y, 3, t.h, borderColor);
+    sprite.fillRect(t.x, t.y + t.h - 3, t.w, 3, borderColor);
+  }
 
-    if (isActive) {
-      uint16_t borderColor = playerTheme.activeBar;
-      sprite.fillRect(0, yBase, SCREEN_W, 3, borderColor);
-      sprite.fillRect(0, yBase, 3, halfH, borderColor);
-      sprite.fillRect(SCREEN_W - 3, yBase, 3, halfH, borderColor);
-      sprite.fillRect(0, yBase + halfH - 3, SCREEN_W, 3, borderColor);
-    }
+  char label[8];
+  snprintf(label, sizeof(label), "P%d", i + 1);
+  sprite.setTextSize(t.labelSize);
+  sprite.setTextColor(alive ? playerTheme.title : COLOR_DIM, playerTheme.menuBg);
+  sprite.setCursor(t.x + 5 * t.labelSize, t.y + 4 * t.labelSize);
+  sprite.print(label);
+
+  int16_t life = gs.players.life[i];
+  uint16_t lifeColor = COLOR_TEXT;
+  if (!alive) lifeColor = COLOR_DIM;
+  else if (life <= 5) lifeColor = COLOR_LIFE_CRIT;
+  else if (life <= 10) lifeColor = COLOR_LIFE_WARN;
+
+  char lifeBuf[8];
+  snprintf(lifeBuf, sizeof(lifeBuf), "%d", life);
+  uint8_t lifeSize = t.lifeSize;
+  sprite.setTextSize(lifeSize);
+  int16_t tw = sprite.textWidth(lifeBuf);
+  while (lifeSize > 2 && tw > t.w - 16) {
+    sprite.setTextSize(--lifeSize);
+    tw = sprite.textWidth(lifeBuf);
+  }
+  sprite.setTextColor(lifeColor, playerTheme.menuBg);
+  sprite.setCursor(t.x + (t.w - tw) / 2, t.y + t.h / 2 - 4 * lifeSize + 3);
+  sprite.print(lifeBuf);
+
+  int16_t poison = counterGet(gs.counters, i, COUNTER_POISON);
+  int16_t cmdrMax = countersMaxCommander(gs.counters, i, gs.playerCount);
+  if (poison > 0 || cmdrMax > 0) {
+    char badge[16];
+    snprintf(badge, sizeof(badge), "psn%d cmd%d", poison, cmdrMax);
+    sprite.setTextSize(1);
+    sprite.setTextColor(COLOR_DIM, playerTheme.menuBg);
+    sprite.setCursor(t.x + 5, t.y + t.h - 12);
+    sprite.print(badge);
+  }
 
-    char label[8];
-    snprintf(label, sizeof(label), "P%d", i + 1);
-    sprite.setTextSize(2);
-    sprite.setTextColor(playerTheme.title, playerTheme.menuBg);
-    sprite.setCursor(10, yBase + 8);
-    sprite.print(label);
+  DrawnTile& d = drawnTiles[i];
+  d.life = life;
+  d.poison = poison;
+  d.cmdrMax = cmdrMax;
+  d.theme = gs.players.theme[i];
+  d.active = isActive && !gs.gameOver;
+  d.alive = alive;
+}
 
-    uint16_t lifeColor = COLOR_TEXT;
-    if (gs.players[i].life <= 5) lifeColor = COLOR_LIFE_CRIT;
-    else if (gs.players[i].life <= 10) lifeColor = COLOR_LIFE_WARN;
+static bool gameTileChanged(const GameState& gs, uint8_t i) {
+  const DrawnTile& d = drawnTiles[i];
+  return d.life != gs.players.life[i] ||
+         d.poison != counterGet(gs.counters, i, COUNTER_POISON) ||
+         d.cmdrMax != countersMaxCommander(gs.counters, i, gs.playerCount) ||
+         d.theme != gs.players.theme[i] ||
+         d.active != (i == gs.activePlayer && !gs.gameOver) ||
+         d.alive != gameIsAlive(gs, i);
+}
 
-    char lifeBuf[8];
-    snprintf(lifeBuf, sizeof(lifeBuf), "%d", gs.players[i].life);
-    sprite.setTextSize(4);
-    sprite.setTextColor(lifeColor, playerTheme.menuBg);
-    int16_t tw = sprite.textWidth(lifeBuf);
-    sprite.setCursor((SCREEN_W - tw) / 2, yBase + 16);
-    sprite.print(lifeBuf);
+static void drawGameDividers(uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    const GameTile& t = gameTiles[i];
+    if (t.y > 0 && t.x == 0) {
+      sprite.drawFastHLine(10, t.y - 1, SCREEN_W - 20, COLOR_DIVIDER);
+    }
+    if (t.x > 0) {
+      sprite.drawFastVLine(t.x - 1, t.y + 6, t.h - 12, COLOR_DIVIDER);
+    }
   }
+}
 
-  sprite.drawFastHLine(10, halfH, SCREEN_W - 20, COLOR_DIVIDER);
-
-  int barY = SCREEN_H - timerH;
+static void drawGameBar(const GameState& gs, TimerMode timerMode) {
+  int barY = SCREEN_H - GAME_BAR_H;
+  sprite.fillRect(0, barY, SCREEN_W, GAME_BAR_H, COLOR_BG);
   sprite.drawFastHLine(0, barY, SCREEN_W, COLOR_DIVIDER);
 
-  unsigned long secs = gameGetMatchSeconds(gs);
   char timerBuf[16];
-  snprintf(timerBuf, sizeof(timerBuf), "%lu:%02lu", secs / 60, secs % 60);
+  uint16_t timerColor = COLOR_DIM;
+  if (timerMode == TIMER_CHESS_CLOCK) {
+    unsigned long secs = (gameBankRemainingMs(gs, gs.activePlayer) + 999) / 1000;
+    snprintf(timerBuf, sizeof(timerBuf), "P%d %lu:%02lu", gs.activePlayer + 1, secs / 60, secs % 60);
+    if (secs <= 60) timerColor = COLOR_LIFE_CRIT;
+  } else if (timerMode == TIMER_PER_TURN) {
+    unsigned long secs = gameGetTurnMs(gs) / 1000;
+    snprintf(timerBuf, sizeof(timerBuf), "T %lu:%02lu", secs / 60, secs % 60);
+  } else {
+    unsigned long secs = gameGetMatchSeconds(gs);
+    snprintf(timerBuf, sizeof(timerBuf), "%lu:%02lu", secs / 60, secs % 60);
+  }
   sprite.setTextSize(1);
-  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setTextColor(timerColor, COLOR_BG);
   sprite.setCursor(6, barY + 5);
   sprite.print(timerBuf);
 
@@ -263,21 +433,107 @@ void displayGame(const GameState& gs, TimerMode timerMode) {
   sprite.print("[B]=Menu");
 
   drawBattery(SCREEN_W - 55, barY + 4);
+}
+
+void displayGame(const GameState& gs, TimerMode timerMode) {
+  layoutGameTiles(gs.playerCount);
+
+  if (!gameScreenValid) {
+    beginDraw();
+    for (uint8_t i = 0; i < gs.playerCount; i++) {
+      drawGameTile(gs, i);
+    }
+    drawGameDividers(gs.playerCount);
+    drawGameBar(gs, timerMode);
+    endDraw();
+    gameScreenValid = true;
+    return;
+  }
 
+  for (uint8_t i = 0; i < gs.playerCount; i++) {
+    if (gameTileChanged(gs, i)) {
+      drawGameTile(gs, i);
+      const GameTile& t = gameTiles[i];
+      endDrawRect(t.x, t.y, t.w, t.h);
+    }
+  }
+  drawGameBar(gs, timerMode);
+  endDrawRect(0, SCREEN_H - GAME_BAR_H, SCREEN_W, GAME_BAR_H);
+}
+
+static void describeEvent(const MatchEvent& ev, char* buf, size_t len) {
+  switch (ev.type) {
+    case EVT_LIFE:
+      snprintf(buf, len, "P%d %+d life", ev.player + 1, ev.value);
+      break;
+    case EVT_COUNTER: {
+      char label[16];
+      counterLabel(ev.arg, label, sizeof(label));
+      snprintf(buf, len, "P%d %+d %s", ev.player + 1, ev.value, label);
+      break;
+    }
+    case EVT_SWITCH:
+      snprintf(buf, len, "P%d ends turn", ev.player + 1);
+      break;
+    case EVT_DICE:
+      snprintf(buf, len, "P%d d%d: %d", ev.player + 1, ev.arg, ev.value);
+      break;
+    case EVT_COIN:
+      snprintf(buf, len, "P%d coin: %s", ev.player + 1, ev.value ? "Heads" : "Tails");
+      break;
+    case EVT_TIMEOUT:
+      snprintf(buf, len, "P%d out of time", ev.player + 1);
+      break;
+    default:
+      snprintf(buf, len, "?");
+      break;
+  }
+}
+
+void displayReplay(const GameState& gs, uint16_t position, uint16_t total, const MatchEvent* last, unsigned long elapsedDs) {
+  layoutGameTiles(gs.playerCount);
+
+  beginDraw();
+  for (uint8_t i = 0; i < gs.playerCount; i++) {
+    drawGameTile(gs, i);
+  }
+  drawGameDividers(gs.playerCount);
+
+  int barY = SCREEN_H - GAME_BAR_H;
+  sprite.fillRect(0, barY, SCREEN_W, GAME_BAR_H, COLOR_BG);
+  sprite.drawFastHLine(0, barY, SCREEN_W, COLOR_DIVIDER);
+
+  char buf[32];
+  unsigned long secs = elapsedDs / 10;
+  snprintf(buf, sizeof(buf), "%u/%u %lu:%02lu", position, total, secs / 60, secs % 60);
+  sprite.setTextSize(1);
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(4, barY + 5);
+  sprite.print(buf);
+
+  if (last) {
+    describeEvent(*last, buf, sizeof(buf));
+  } else {
+    snprintf(buf, sizeof(buf), "Start");
+  }
+  sprite.setTextColor(COLOR_TEXT, COLOR_BG);
+  sprite.setCursor(SCREEN_W - 4 - sprite.textWidth(buf), barY + 5);
+  sprite.print(buf);
   endDraw();
+  gameScreenValid = false;
 }
 
 void displayGameMenu(const GameState& gs, uint8_t selection) {
   beginDraw(theme->menuBg);
   drawCentered("= MENU =", 5, 2, theme->title, theme->menuBg);
 
-  const char* items[] = {"Switch Player", "Roll Dice", "Flip Coin", "Settings", "Reset Game"};
+  const char* items[] = {"Switch Player", "Counters", "Quick Entry", "Roll Dice", "Flip Coin", "Turn Stats", "Settings", "Reset Game"};
   for (uint8_t i = 0; i < GMENU_COUNT; i++) {
-    int y = 28 + i * 16;
+    int y = 26 + i * 12;
     bool sel = (i == selection);
     uint16_t bg = sel ? theme->selBg : theme->menuBg;
     if (sel) {
-      sprite.fillRoundRect(15, y - 2, SCREEN_W - 30, 15, 3, theme->selBg);
+      sprite.fillRoundRect(15, y - 2, SCREEN_W - 30, 12, 3, theme->selBg);
     }
     uint16_t color = sel ? theme->selText : COLOR_TEXT;
     drawCentered(items[i], y, 1, color, bg);
@@ -290,6 +546,102 @@ void displayGameMenu(const GameState& gs, uint8_t selection) {
   endDraw();
 }
 
+void displayCounters(const GameState& gs, uint8_t selection) {
+  beginDraw();
+
+  uint8_t player = gs.activePlayer;
+  char buf[24];
+  snprintf(buf, sizeof(buf), "P%d Counters", player + 1);
+  drawCentered(buf, 3, 2, theme->accent);
+
+  uint8_t slotCount = COUNTER_CMDR_BASE + gs.playerCount;
+  uint8_t row = 0;
+  for (uint8_t slot = 0; slot < slotCount; slot++) {
+    if (slot == COUNTER_CMDR_BASE + player) continue;
+
+    int y = 23 + row * 10;
+    bool sel = (slot == selection);
+    uint16_t bg = sel ? theme->selBg : COLOR_BG;
+    if (sel) {
+      sprite.fillRoundRect(8, y - 2, SCREEN_W - 16, 11, 2, theme->selBg);
+    }
+
+    uint16_t color = sel ? theme->selText : COLOR_DIM;
+    if (counterIsLethal(gs.counters, player, slot)) color = COLOR_LIFE_CRIT;
+
+    sprite.setTextSize(1);
+    sprite.setTextColor(color, bg);
+    counterLabel(slot, buf, sizeof(buf));
+    sprite.setCursor(14, y);
+    sprite.print(buf);
+
+    uint8_t limit = counterLethalAt(slot);
+    if (limit > 0) {
+      snprintf(buf, sizeof(buf), "%d/%d", counterGet(gs.counters, player, slot), limit);
+    } else {
+      snprintf(buf, sizeof(buf), "%d", counterGet(gs.counters, player, slot));
+    }
+    sprite.setCursor(150, y);
+    sprite.print(buf);
+    row++;
+  }
+
+  // The row after the counters leaves the screen.
+  int y = 23 + row * 10;
+  bool sel = (selection == slotCount);
+  if (sel) {
+    sprite.fillRoundRect(8, y - 2, SCREEN_W - 16, 11, 2, theme->selBg);
+  }
+  sprite.setTextColor(sel ? theme->selText : COLOR_DIM, sel ? theme->selBg : COLOR_BG);
+  sprite.setCursor(14, y);
+  sprite.print("Done");
+
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(5, 125);
+  sprite.print(selection == slotCount ? "[OK] Back to game  [B] Next" : "[OK]+1 [A]-1 [B]Next");
+  endDraw();
+}
+
+void displayQuickEntry(const GameState& gs, int8_t sign, const uint8_t* digits, uint8_t field) {
+  beginDraw();
+
+  char buf[24];
+  snprintf(buf, sizeof(buf), "P%d Quick Entry", gs.activePlayer + 1);
+  drawCentered(buf, 5, 2, theme->accent);
+
+  snprintf(buf, sizeof(buf), "Life: %d", gs.players.life[gs.activePlayer]);
+  drawCentered(buf, 28, 1, COLOR_DIM);
+
+  const int cellW = 30;
+  int startX = (SCREEN_W - (QUICK_ENTRY_DIGITS + 1) * cellW) / 2;
+  sprite.setTextSize(4);
+  for (uint8_t i = 0; i <= QUICK_ENTRY_DIGITS; i++) {
+    int x = startX + i * cellW;
+    bool sel = (i == field);
+    uint16_t bg = sel ? theme->selBg : COLOR_BG;
+    if (sel) sprite.fillRoundRect(x, 44, cellW - 2, 38, 4, theme->selBg);
+
+    char c = (i == 0) ? (sign < 0 ? '-' : '+') : (char)('0' + digits[i - 1]);
+    sprite.setTextColor(sel ? theme->selText : COLOR_TEXT, bg);
+    sprite.setCursor(x + 3, 49);
+    sprite.print(c);
+  }
+
+  bool applySel = (field == QUICK_ENTRY_DIGITS + 1);
+  if (applySel) {
+    sprite.fillRoundRect(70, 90, SCREEN_W - 140, 18, 4, theme->selBg);
+    drawCentered("Apply", 92, 2, theme->selText, theme->selBg);
+  } else {
+    drawCentered("Apply", 92, 2, COLOR_DIM);
+  }
+
+  sprite.setTextSize(1);
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(15, 122);
+  sprite.print("[OK] Change  [A] Next  [B] Cancel");
+  endDraw();
+}
+
 void displayDice(const GameState& gs) {
   beginDraw();
 
@@ -351,6 +703,60 @@ void displayCoin(const GameState& gs) {
   endDraw();
 }
 
+static void formatMinSec(char* buf, size_t len, unsigned long ms) {
+  unsigned long secs = (ms + 500) / 1000;
+  snprintf(buf, len, "%lu:%02lu", secs / 60, secs % 60);
+}
+
+void displayTurnStats(const GameState& gs) {
+  beginDraw();
+  drawCentered("Turn Stats", 3, 2, theme->accent);
+
+  sprite.setTextSize(1);
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(8, 22);
+  sprite.print("   Turns    Avg    Max  Total");
+
+  char avg[12], mx[12], total[12], buf[48];
+  for (uint8_t i = 0; i < gs.playerCount; i++) {
+    const TurnAggregate& a = turnTimerAggregate(i);
+    formatMinSec(avg, sizeof(avg), turnTimerMeanMs(i));
+    formatMinSec(mx, sizeof(mx), a.maxMs);
+    formatMinSec(total, sizeof(total), a.totalMs);
+    snprintf(buf, sizeof(buf), "P%d %5u %6s %6s %6s", i + 1, a.turns, avg, mx, total);
+    sprite.setTextColor(i == gs.activePlayer ? COLOR_TEXT : COLOR_DIM, COLOR_BG);
+    sprite.setCursor(8, 34 + i * 11);
+    sprite.print(buf);
+  }
+
+  uint8_t recentPlayer[3];
+  uint32_t recentSecs[3];
+  uint8_t recentCount = 0;
+  uint16_t offset = 0;
+  uint8_t player;
+  uint32_t secs;
+  while (turnTimerLogNext(offset, player, secs)) {
+    recentPlayer[recentCount % 3] = player;
+    recentSecs[recentCount % 3] = secs;
+    recentCount++;
+  }
+
+  int len = snprintf(buf, sizeof(buf), "Last:");
+  uint8_t shown = recentCount < 3 ? recentCount : 3;
+  for (uint8_t k = 0; k < shown && len < (int)sizeof(buf); k++) {
+    uint8_t idx = (recentCount - 1 - k) % 3;
+    len += snprintf(buf + len, sizeof(buf) - len, " P%d %lu:%02lu", recentPlayer[idx] + 1,
+                    (unsigned long)recentSecs[idx] / 60, (unsigned long)recentSecs[idx] % 60);
+  }
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(8, 104);
+  sprite.print(buf);
+
+  sprite.setCursor(8, 122);
+  sprite.print("[B] Back");
+  endDraw();
+}
+
 void displayConfirmReset(uint8_t selection) {
   beginDraw();
   drawCentered("Reset Game?", 20, 2, MTG_RED);
@@ -377,7 +783,7 @@ void displayConfirmReset(uint8_t selection) {
 void displayGameOver(const GameState& gs, TimerMode timerMode) {
   beginDraw();
 
-  uint8_t winner = (gs.loserIndex == 0) ? 1 : 0;
+  uint8_t winner = gs.winnerIndex;
   char buf[32];
 
   drawCentered("GAME OVER", 8, 2, MTG_RED);
@@ -385,17 +791,18 @@ void displayGameOver(const GameState& gs, TimerMode timerMode) {
   snprintf(buf, sizeof(buf), "Player %d Wins!", winner + 1);
   drawCentered(buf, 32, 2, MTG_WHITE);
 
-  for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
-    int y = 60 + i * 16;
-    snprintf(buf, sizeof(buf), "P%d: %d LP", i + 1, gs.players[i].life);
+  for (uint8_t i = 0; i < gs.playerCount; i++) {
+    int x = (gs.playerCount > 3) ? 30 + (i / 3) * 100 : 70;
+    int y = 60 + (i % 3) * 12;
+    snprintf(buf, sizeof(buf), "P%d: %d LP", i + 1, gs.players.life[i]);
     sprite.setTextSize(1);
-    uint16_t color = (i == gs.loserIndex) ? MTG_RED : MTG_GREEN;
+    uint16_t color = (i == winner) ? MTG_GREEN : MTG_RED;
     sprite.setTextColor(color, COLOR_BG);
-    sprite.setCursor(70, y);
+    sprite.setCursor(x, y);
     sprite.print(buf);
   }
 
-  unsigned long matchSecs = (gs.matchStartMs > 0) ? ((millis() - gs.matchStartMs) / 1000) : 0;
+  unsigned long matchSecs = gameGetMatchSeconds(gs);
   snprintf(buf, sizeof(buf), "Duration: %lu:%02lu", matchSecs / 60, matchSecs % 60);
   sprite.setTextSize(1);
   sprite.setTextColor(COLOR_DIM, COLOR_BG);
@@ -403,8 +810,8 @@ void displayGameOver(const GameState& gs, TimerMode timerMode) {
   sprite.print(buf);
 
   sprite.setTextColor(COLOR_DIM, COLOR_BG);
-  sprite.setCursor(30, 115);
-  sprite.print("[OK] New Game  [B] Menu");
+  sprite.setCursor(15, 115);
+  sprite.print("[OK]New Game [A]Replay [B]Menu");
   endDraw();
 }
 
@@ -413,9 +820,10 @@ void displaySettings(uint8_t selection, uint8_t brightness, uint8_t volume, Time
   drawCentered("Settings", 2, 2, theme->accent);
 
   const char* themeNames[] = {"Plains", "Island", "Swamp", "Mountain", "Forest"};
+  const char* timerNames[] = {"Per turn", "Per match", "Chess clock"};
 
   for (uint8_t i = 0; i < SET_COUNT; i++) {
-    int y = 18 + i * 13;
+    int y = 18 + i * 12;
     bool sel = (i == selection);
     uint16_t bg = sel ? theme->selBg : COLOR_BG;
     uint16_t color = sel ? theme->selText : COLOR_DIM;
@@ -457,6 +865,12 @@ void displaySettings(uint8_t selection, uint8_t brightness, uint8_t volume, Time
       sprite.setCursor(90, y);
       sprite.print(themeNames[themeId]);
     }
+    else if (i == SET_TIMER_MODE) {
+      sprite.setCursor(14, y);
+      sprite.print("Timer:");
+      sprite.setCursor(90, y);
+      sprite.print(timerNames[timerMode]);
+    }
     else if (i == SET_FACE_DOWN_PAUSE) {
       sprite.setCursor(14, y);
       sprite.print("Face down:");
@@ -525,47 +939,41 @@ void displayAbout() {
   endDraw();
 }
 
-void displayDiceAnimation(uint8_t sides) {
+void displayDiceAnimationFrame(uint8_t sides) {
   char title[8];
   snprintf(title, sizeof(title), "D%d", sides);
-  for (int i = 0; i < 8; i++) {
-    beginDraw();
-    drawCentered(title, 10, 2, theme->accent);
-    int boxSize = 60;
-    int bx = (SCREEN_W - boxSize) / 2;
-    int by = 35;
-    sprite.drawRoundRect(bx, by, boxSize, boxSize, 6, COLOR_DIM);
-    sprite.drawRoundRect(bx + 1, by + 1, boxSize - 2, boxSize - 2, 5, COLOR_DIM);
+  beginDraw();
+  drawCentered(title, 10, 2, theme->accent);
+  int boxSize = 60;
+  int bx = (SCREEN_W - boxSize) / 2;
+  int by = 35;
+  sprite.drawRoundRect(bx, by, boxSize, boxSize, 6, COLOR_DIM);
+  sprite.drawRoundRect(bx + 1, by + 1, boxSize - 2, boxSize - 2, 5, COLOR_DIM);
 
-    int randomNum = random(1, sides + 1);
-    char buf[8];
-    snprintf(buf, sizeof(buf), "%d", randomNum);
-    sprite.setTextSize(4);
-    sprite.setTextColor(COLOR_DIM, COLOR_BG);
-    int16_t tw = sprite.textWidth(buf);
-    int th = 28;
-    sprite.setCursor(bx + (boxSize - tw) / 2, by + (boxSize - th) / 2);
-    sprite.print(buf);
+  int randomNum = prngRange(PRNG_ANIMATION, 1, sides + 1);
+  char buf[8];
+  snprintf(buf, sizeof(buf), "%d", randomNum);
+  sprite.setTextSize(4);
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  int16_t tw = sprite.textWidth(buf);
+  int th = 28;
+  sprite.setCursor(bx + (boxSize - tw) / 2, by + (boxSize - th) / 2);
+  sprite.print(buf);
 
-    endDraw();
-    delay(50 + i * 15);
-  }
+  endDraw();
 }
 
-void displayCoinAnimation() {
+void displayCoinAnimationFrame(uint8_t frame) {
   const char* faces[] = {"HEADS", "TAILS"};
-  for (int i = 0; i < 6; i++) {
-    beginDraw();
-    drawCentered("Coin Flip", 10, 2, theme->accent);
-    drawCentered(faces[i % 2], 55, 2, COLOR_DIM);
-    endDraw();
-    delay(80 + i * 20);
-  }
+  beginDraw();
+  drawCentered("Coin Flip", 10, 2, theme->accent);
+  drawCentered(faces[frame % 2], 55, 2, COLOR_DIM);
+  endDraw();
 }
 
 void displayVictoryAnimation(uint8_t winnerIdx, const GameState& gs) {
   ColorTheme winnerTheme;
-  memcpy_P(&winnerTheme, &THEMES[gs.players[winnerIdx].theme], sizeof(ColorTheme));
+  memcpy_P(&winnerTheme, &THEMES[gs.players.theme[winnerIdx]], sizeof(ColorTheme));
 
   for (int i = 0; i < 5; i++) {
     beginDraw();
@@ -575,7 +983,7 @@ void displayVictoryAnimation(uint8_t winnerIdx, const GameState& gs) {
       sprite.drawCircle(SCREEN_W / 2, SCREEN_H / 2, radius - 15, winnerTheme.accent);
     }
     endDraw();
-    delay(100);
+    perfDelay(100);
   }
 
   for (int i = 0; i < 10; i++) {
@@ -594,13 +1002,13 @@ void displayVictoryAnimation(uint8_t winnerIdx, const GameState& gs) {
     sprite.setCursor((SCREEN_W - w) / 2, 70);
     sprite.print("WINS!");
     endDraw();
-    delay(100);
+    perfDelay(100);
   }
 
   for (int i = 0; i < 5; i++) {
     beginDraw(i % 2 == 0 ? COLOR_BG : winnerTheme.menuBg);
     endDraw();
-    delay(100);
+    perfDelay(100);
   }
 }
 
@@ -611,6 +1019,7 @@ void displayDiagnostics(uint8_t selection, bool hasEasterEggs) {
   const char* allItems[] = {
     "Battery Info",
     "System Info",
+    "Performance",
     "Game Stats",
     "Temperature",
     "IMU Status",
@@ -714,6 +1123,7 @@ void displayBatteryInfo() {
   sprite.setCursor(20, 98);  sprite.print("4.2V = 100% (full)");
   sprite.setCursor(20, 110); sprite.print("3.7V = ~50% (nominal)");
   sprite.setCursor(20, 122); sprite.print("3.0V = 0% (empty)");
+  sprite.setCursor(170, 122); sprite.print("[OK] Graph");
 
   sprite.setTextColor(COLOR_DIM, COLOR_BG);
   sprite.setCursor(185, 3);
@@ -796,14 +1206,218 @@ void displaySystemInfo() {
   if (fillW > 0) sprite.fillRect(barX + 1, barY + 1, fillW - 1, barH - 2, theme->accent);
 
   sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(170, 112);
+  sprite.print("[OK] Graph");
   sprite.setCursor(185, 3);
   sprite.print("[B]");
 
   endDraw();
 }
 
+static void printMs(char* buf, size_t len, uint32_t us) {
+  snprintf(buf, len, "%lu.%lu", (unsigned long)(us / 1000), (unsigned long)(us / 100 % 10));
+}
+
+void displayPerf(const PerfStats& ps, const TiltStats& ts, bool overlay) {
+  beginDraw();
+  drawCentered("Performance", 3, 2, theme->accent);
+
+  const char* labels[] = { "Loop:", "Frame ms:", "Heap KB:", "Bus:", "Tilt us:" };
+  char lines[5][40];
+  char avg[8], p99[8], worst[8];
+  printMs(avg, sizeof(avg), ps.frameAvgUs);
+  printMs(p99, sizeof(p99), ps.frameP99Us);
+  printMs(worst, sizeof(worst), ps.frameMaxUs);
+  snprintf(lines[0], sizeof(lines[0]), "%lu/s  blocked %u%%", (unsigned long)ps.loopsPerSec, ps.blockedPct);
+  snprintf(lines[1], sizeof(lines[1]), "avg %s p99 %s max %s", avg, p99, worst);
+  snprintf(lines[2], sizeof(lines[2]), "%.1f free  %.1f min", ps.freeHeap / 1024.0f, ps.minFreeHeap / 1024.0f);
+  snprintf(lines[3], sizeof(lines[3]), "I2C %lu/s  SPI %lu KB/s",
+           (unsigned long)ps.i2cPerSec, (unsigned long)(ps.spiBytesPerSec / 1024));
+  // Filter cost per sample in the last tilt session, against TILT_FILTER_BUDGET_US.
+  if (ts.samples == 0) {
+    snprintf(lines[4], sizeof(lines[4]), "not run yet");
+  } else {
+    snprintf(lines[4], sizeof(lines[4]), "avg %u max %u  over %lu", ts.meanUs, ts.maxUs, (unsigned long)ts.overruns);
+  }
+
+  sprite.setTextSize(1);
+  for (uint8_t i = 0; i < 5; i++) {
+    int y = 22 + i * 12;
+    sprite.setTextColor(COLOR_TEXT, COLOR_BG);
+    sprite.setCursor(8, y);
+    sprite.print(labels[i]);
+    sprite.setTextColor(COLOR_DIM, COLOR_BG);
+    sprite.setCursor(68, y);
+    sprite.print(lines[i]);
+  }
+
+  // Bytes of stack never touched since each task started.
+  sprite.setTextColor(COLOR_TEXT, COLOR_BG);
+  sprite.setCursor(8, 84);
+  sprite.print("Stack free:");
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  for (uint8_t i = 0; i < ps.taskCount; i++) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%s %lu", ps.tasks[i].name, (unsigned long)ps.tasks[i].stackFree);
+    sprite.setCursor(8 + (i % 3) * 76, 96 + (i / 3) * 12);
+    sprite.print(buf);
+  }
+
+  sprite.setCursor(20, 125);
+  sprite.print(overlay ? "[OK] HUD off  [B] Back" : "[OK] HUD on  [B] Back");
+
+  sprite.setCursor(185, 3);
+  sprite.print("[B]");
+  endDraw();
+}
+
+#define TG_TOP   20
+#define TG_H     (SCREEN_H - TG_TOP - 11)
+#define TG_COLS  SCREEN_W
+
+struct TelemetryGraph {
+  uint8_t channel;
+  uint16_t spp;
+  uint32_t endCol;
+  uint32_t drawn;
+  int16_t lo, hi;
+};
+
+static TelemetryGraph tg;
+static int16_t tgLo[TG_COLS];
+static int16_t tgHi[TG_COLS];
+
+static const char* const TELE_NAMES[TELE_CHANNELS] = { "Battery", "Level", "Temp", "Heap", "CPU" };
+static const int16_t TELE_MIN_RANGE[TELE_CHANNELS] = { 50, 5, 20, 16, 40 };
+
+static void teleFormat(char* buf, size_t len, uint8_t ch, int16_t v) {
+  switch (ch) {
+    case TELE_BATT_MV:  snprintf(buf, len, "%d mV", v); break;
+    case TELE_BATT_PCT: snprintf(buf, len, "%d%%", v); break;
+    case TELE_TEMP_DC:  snprintf(buf, len, "%.1f C", v / 10.0f); break;
+    case TELE_HEAP:     snprintf(buf, len, "%.1f KB", v * (float)TELEMETRY_HEAP_UNIT / 1024); break;
+    default:            snprintf(buf, len, "%d MHz", v); break;
+  }
+}
+
+static int tgY(int16_t v) {
+  return TG_TOP + TG_H - 1 - (int32_t)(v - tg.lo) * (TG_H - 1) / (tg.hi - tg.lo);
+}
+
+static void tgDrawColumn(int x, int16_t lo, int16_t hi) {
+  sprite.drawFastVLine(x, TG_TOP, TG_H, COLOR_BG);
+  for (uint8_t g = 1; g < 4; g++) sprite.drawPixel(x, TG_TOP + g * TG_H / 4, COLOR_DIM);
+  if (lo > hi) return;
+  int y0 = tgY(hi);
+  sprite.drawFastVLine(x, y0, tgY(lo) - y0 + 1, theme->accent);
+}
+
+static void tgDrawHeader(uint16_t intervalS) {
+  sprite.fillRect(0, 0, SCREEN_W, TG_TOP, COLOR_BG);
+  sprite.setTextSize(1);
+  char buf[24];
+  char val[16];
+  teleFormat(val, sizeof(val), tg.channel, telemetryLatest(tg.channel));
+  snprintf(buf, sizeof(buf), "%s %s", TELE_NAMES[tg.channel], val);
+  sprite.setTextColor(theme->accent, COLOR_BG);
+  sprite.setCursor(2, 2);
+  sprite.print(buf);
+
+  uint32_t span = telemetrySpanSeconds();
+  snprintf(buf, sizeof(buf), "%luh%02lum", (unsigned long)(span / 3600), (unsigned long)(span / 60 % 60));
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(SCREEN_W - 2 - sprite.textWidth(buf), 2);
+  sprite.print(buf);
+
+  char lo[12], hi[12];
+  teleFormat(hi, sizeof(hi), tg.channel, tg.hi);
+  teleFormat(lo, sizeof(lo), tg.channel, tg.lo);
+  snprintf(buf, sizeof(buf), "%s..%s", lo, hi);
+  sprite.setCursor(2, 11);
+  sprite.print(buf);
+  uint32_t colS = (uint32_t)tg.spp * intervalS;
+  if (colS >= 60) snprintf(buf, sizeof(buf), "1px=%lum", (unsigned long)(colS / 60));
+  else snprintf(buf, sizeof(buf), "1px=%lus", (unsigned long)colS);
+  sprite.setCursor(SCREEN_W - 2 - sprite.textWidth(buf), 11);
+  sprite.print(buf);
+}
+
+static void tgFull(uint16_t intervalS) {
+  // Right-aligned: until the ring spans the full width the left edge is
+  // before the first sample.
+  uint16_t skip = (tg.endCol < TG_COLS) ? TG_COLS - tg.endCol : 0;
+  for (uint16_t c = 0; c < skip; c++) {
+    tgLo[c] = INT16_MAX;
+    tgHi[c] = INT16_MIN;
+  }
+  telemetryColumns(tg.channel, tg.spp, tg.endCol - (TG_COLS - skip), TG_COLS - skip, tgLo + skip, tgHi + skip);
+  int16_t lo = INT16_MAX, hi = INT16_MIN;
+  for (uint16_t c = 0; c < TG_COLS; c++) {
+    if (tgLo[c] > tgHi[c]) continue;
+    if (tgLo[c] < lo) lo = tgLo[c];
+    if (tgHi[c] > hi) hi = tgHi[c];
+  }
+  int16_t latest = telemetryLatest(tg.channel);
+  if (lo > hi) lo = hi = latest;
+  // Headroom so the next few columns scroll in without a rescale.
+  int16_t pad = (hi - lo) / 8 + TELE_MIN_RANGE[tg.channel] / 2;
+  tg.lo = lo - pad;
+  tg.hi = hi + pad;
+
+  beginDraw();
+  for (uint16_t c = 0; c < TG_COLS; c++) tgDrawColumn(c, tgLo[c], tgHi[c]);
+  tgDrawHeader(intervalS);
+  tg.drawn = drawCount;
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(2, SCREEN_H - 9);
+  char buf[40];
+  snprintf(buf, sizeof(buf), "[OK] Next  [A] Every %us  [B] Back", intervalS);
+  sprite.print(buf);
+  endDraw();
+}
+
+// Plots the last TG_COLS columns of spp samples each, with spp the
+// smallest power of two that fits the whole ring on screen. As samples
+// arrive the plot scrolls left and only the new columns are drawn; it is
+// redrawn in full only when the scale or the channel changes.
+void displayTelemetry(uint8_t channel, uint16_t intervalS, bool full) {
+  uint32_t kept = telemetryEndSeq() - telemetryFirstSeq();
+  uint16_t spp = 1;
+  while ((uint32_t)spp * TG_COLS < kept) spp <<= 1;
+  uint32_t endCol = telemetryEndSeq() / spp;
+
+  // Anything else drawn since means the canvas no longer holds the plot.
+  if (full || tg.drawn != drawCount || tg.channel != channel || tg.spp != spp) {
+    tg.channel = channel;
+    tg.spp = spp;
+    tg.endCol = endCol;
+    tgFull(intervalS);
+    return;
+  }
+
+  uint32_t fresh = endCol - tg.endCol;
+  if (fresh > 0) {
+    if (fresh > TG_COLS) fresh = TG_COLS;
+    telemetryColumns(channel, spp, endCol - fresh, fresh, tgLo, tgHi);
+    for (uint16_t c = 0; c < fresh; c++) {
+      if (tgLo[c] <= tgHi[c] && (tgLo[c] < tg.lo || tgHi[c] > tg.hi)) {
+        tg.endCol = endCol;
+        tgFull(intervalS);
+        return;
+      }
+    }
+    sprite.setScrollRect(0, TG_TOP, SCREEN_W, TG_H);
+    sprite.scroll(-(int)fresh, 0);
+    sprite.clearScrollRect();
+    for (uint16_t c = 0; c < fresh; c++) tgDrawColumn(SCREEN_W - fresh + c, tgLo[c], tgHi[c]);
+    tg.endCol = endCol;
+  }
+  tgDrawHeader(intervalS);
+  endDrawRect(0, 0, SCREEN_W, TG_TOP + TG_H);
+}
+
 void displayGameStats(uint16_t totalMatches, uint32_t totalPlaytime,
-                      uint16_t p1Wins, uint16_t p2Wins,
+                      const uint16_t* playerWins,
                       uint16_t diceRolls, uint16_t coinFlips) {
   beginDraw();
   drawCentered("Game Statistics", 3, 2, theme->accent);
@@ -845,19 +1459,22 @@ void displayGameStats(uint16_t totalMatches, uint32_t totalPlaytime,
 
   sprite.drawLine(20, 62, SCREEN_W - 20, 62, COLOR_DIM);
 
+  char wins[24];
   sprite.setTextColor(COLOR_TEXT, COLOR_BG);
   sprite.setCursor(20, 68);
-  sprite.print("Player 1 wins:");
+  sprite.print("P1/P2/P3 wins:");
   sprite.setCursor(150, 68);
   sprite.setTextColor(MTG_GREEN, COLOR_BG);
-  sprite.print(p1Wins);
+  snprintf(wins, sizeof(wins), "%u/%u/%u", playerWins[0], playerWins[1], playerWins[2]);
+  sprite.print(wins);
 
   sprite.setTextColor(COLOR_TEXT, COLOR_BG);
   sprite.setCursor(20, 80);
-  sprite.print("Player 2 wins:");
+  sprite.print("P4/P5/P6 wins:");
   sprite.setCursor(150, 80);
   sprite.setTextColor(MTG_BLUE, COLOR_BG);
-  sprite.print(p2Wins);
+  snprintf(wins, sizeof(wins), "%u/%u/%u", playerWins[3], playerWins[4], playerWins[5]);
+  sprite.print(wins);
 
   sprite.drawLine(20, 94, SCREEN_W - 20, 94, COLOR_DIM);
 
@@ -929,6 +1546,8 @@ void displayTemperature() {
   sprite.print("Safe range: < 60");
   sprite.print((char)247);
   sprite.print("C");
+  sprite.setCursor(170, 115);
+  sprite.print("[OK] Graph");
 
   sprite.setCursor(185, 3);
   sprite.print("[B]");
@@ -951,6 +1570,7 @@ void displayIMUStatus() {
 
   float accX, accY, accZ;
   M5.Imu.getAccel(&accX, &accY, &accZ);
+  perfCountI2C();
 
   sprite.setTextColor(COLOR_TEXT, COLOR_BG);
   sprite.setCursor(20, 40);
@@ -1017,11 +1637,12 @@ void displayTestMenu(uint8_t selection) {
     "Button Test",
     "Screen Test",
     "Speaker Test",
+    "Benchmark",
     "< Back"
   };
 
-  int topMargin = 30;
-  int spacing = 18;
+  int topMargin = 28;
+  int spacing = 15;
 
   for (uint8_t i = 0; i < TEST_COUNT; i++) {
     int y = topMargin + i * spacing;
@@ -1048,6 +1669,43 @@ void displayTestMenu(uint8_t selection) {
   endDraw();
 }
 
+void displayBenchmark() {
+  beginDraw();
+  drawCentered("Benchmark", 3, 2, theme->accent);
+
+  const BenchmarkResult* results = benchmarkResults();
+  uint8_t done = benchmarkNext();
+  sprite.setTextSize(1);
+  for (uint8_t i = 0; i < BENCH_COUNT; i++) {
+    int y = 22 + i * 9;
+    sprite.setTextColor(COLOR_TEXT, COLOR_BG);
+    sprite.setCursor(10, y);
+    sprite.print(benchmarkName(i));
+
+    char buf[24];
+    const char* text = buf;
+    uint16_t color = COLOR_DIM;
+    if (i > done) {
+      text = "";
+    } else if (i == done) {
+      text = "...";
+    } else if (!results[i].ok) {
+      text = "n/a";
+      color = MTG_RED;
+    } else {
+      snprintf(buf, sizeof(buf), "%.1f %s", results[i].value, benchmarkUnit(i));
+    }
+    sprite.setTextColor(color, COLOR_BG);
+    sprite.setCursor(110, y);
+    sprite.print(text);
+  }
+
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(20, 125);
+  sprite.print(benchmarkRunning() ? "Running..." : "[OK] Rerun  [B] Back");
+  endDraw();
+}
+
 void displayIMUCalibration(bool inProgress, uint8_t samplesCollected, float magnitude) {
   beginDraw();
   drawCentered("IMU Calibration", 5, 2, theme->accent);
@@ -1198,6 +1856,12 @@ void displaySpeakerTest(uint16_t frequency) {
   sprite.setCursor(30, 95);
   sprite.print("frequency");
 
+  MixerStats mix = mixerGetStats();
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(30, 107);
+  sprite.printf("Mixer %uus max %uus/%ums", mix.lastUs, mix.maxUs,
+                (unsigned)(MIXER_BLOCK * 1000UL / MIXER_SAMPLE_RATE));
+
   sprite.setTextColor(COLOR_DIM, COLOR_BG);
   sprite.setCursor(30, 120);
   sprite.print("[OK] +100  [A] -100  [B] Exit");
@@ -1209,27 +1873,70 @@ void displaySpeakerTest(uint16_t frequency) {
 }
 
 M5Canvas& displayGetSprite() { return sprite; }
+void displayInvalidate() { gameScreenValid = false; }
 void displayBeginDraw(uint16_t bg) { beginDraw(bg); }
 void displayEndDraw() { endDraw(); }
+void displayPushRect(int x, int y, int w, int h) { endDrawRect(x, y, w, h); }
+void displaySetPerfOverlay(bool on) { perfOverlay = on; }
+
+// Refreshes only the overlay, for screens that are not being redrawn.
+void displayPerfOverlay() {
+  if (!perfOverlay || !spriteReady) return;
+  M5.Display.setClipRect(0, 0, PERF_HUD_W, PERF_HUD_H);
+  drawPerfOverlay();
+  sprite.pushSprite(0, 0);
+  M5.Display.clearClipRect();
+  perfCountSpi(PERF_HUD_W * PERF_HUD_H * 2);
+}
+
+// Copies a pre-rasterized sprite into the canvas one opaque run at a time,
+// clipped to the screen. See tools/spritegen.py for the data layout.
+void displayBlit(uint8_t spriteId, int x, int y) {
+  if (spriteId >= SPR_COUNT || !spriteReady) return;
+  SpriteDef def;
+  memcpy_P(&def, &SPRITES[spriteId], sizeof(SpriteDef));
+  uint16_t* buf = (uint16_t*)sprite.getBuffer();
+
+  const uint16_t* src = def.pixels;
+  for (uint8_t i = 0; i < def.spanCount; i++) {
+    int sy = y + pgm_read_byte(&def.spans[i * 3]);
+    int sx = x + pgm_read_byte(&def.spans[i * 3 + 1]);
+    int len = pgm_read_byte(&def.spans[i * 3 + 2]);
+    const uint16_t* run = src;
+    src += len;
+
+    if (sy < 0 || sy >= SCREEN_H) continue;
+    if (sx < 0) {
+      run -= sx;
+      len += sx;
+      sx = 0;
+    }
+    if (sx + len > SCREEN_W) len = SCREEN_W - sx;
+    if (len <= 0) continue;
+    memcpy_P(&buf[sy * SCREEN_W + sx], run, len * sizeof(uint16_t));
+  }
+}
 void displayDrawCentered(const char* t, int y, uint8_t s, uint16_t c, uint16_t bg) {
   drawCentered(t, y, s, c, bg);
 }
 const ColorTheme* displayGetTheme() { return theme; }
 
-void displayEasterEggsMenu(uint8_t selection) {
+void displayEasterEggsMenu(uint8_t selection, const char* mode) {
   beginDraw();
   drawCentered("Easter Eggs", 5, 2, 0xFEA0);
 
-  const char* items[] = {"Mana Runner", "Arena Battle", "Snake", "Spell Dodge", "< Back"};
-  int spacing = 18;
-  int topY = 30;
+  char modeItem[20];
+  snprintf(modeItem, sizeof(modeItem), "Mode: %s", mode);
+  const char* items[] = {"Mana Runner", "Arena Battle", "Snake", "Spell Dodge", modeItem, "High Scores", "< Back"};
+  int spacing = 12;
+  int topY = 26;
 
   for (uint8_t i = 0; i < EE_COUNT; i++) {
     int y = topY + i * spacing;
     bool sel = (i == selection);
 
     if (sel) {
-      sprite.fillRoundRect(20, y - 3, SCREEN_W - 40, 16, 3, theme->selBg);
+      sprite.fillRoundRect(20, y - 2, SCREEN_W - 40, 12, 3, theme->selBg);
       sprite.setTextSize(1);
       sprite.setTextColor(theme->selText, theme->selBg);
       sprite.setCursor(35, y);
@@ -1242,6 +1949,8 @@ void displayEasterEggsMenu(uint8_t selection) {
     }
   }
 
+  drawCentered("[OK] Select  [A] Next  [B] Back", 114, 1, COLOR_DIM);
+
   uint16_t manaColors[] = {MTG_WHITE, MTG_BLUE, MTG_BLACK, MTG_RED, MTG_GREEN};
   int startX = (SCREEN_W - 5 * 20) / 2;
   for (int i = 0; i < 5; i++) {
@@ -1251,9 +1960,13 @@ void displayEasterEggsMenu(uint8_t selection) {
   endDraw();
 }
 
-void displayMiniGameOver(uint16_t score) {
+void displayMiniGameOver(uint16_t score, bool won) {
   beginDraw();
-  drawCentered("GAME OVER", 25, 3, MTG_RED);
+  if (won) {
+    drawCentered("YOU WIN!", 25, 3, MTG_GREEN);
+  } else {
+    drawCentered("GAME OVER", 25, 3, MTG_RED);
+  }
 
   char buf[16];
   snprintf(buf, sizeof(buf), "Score: %d", score);
@@ -1266,3 +1979,61 @@ void displayMiniGameOver(uint16_t score) {
   endDraw();
 }
 
+void displayMgInitials(const char* game, uint16_t score, uint8_t rank, const char* initials, uint8_t pos) {
+  beginDraw();
+  drawCentered("NEW HIGH SCORE", 5, 2, theme->accent);
+
+  char buf[40];
+  snprintf(buf, sizeof(buf), "%s  #%d  %u", game, rank + 1, score);
+  drawCentered(buf, 28, 1, COLOR_TEXT);
+
+  int slotW = 32;
+  int startX = (SCREEN_W - MG_INITIALS * slotW) / 2;
+  sprite.setTextSize(4);
+  for (uint8_t i = 0; i < MG_INITIALS; i++) {
+    int x = startX + i * slotW + 4;
+    uint16_t color = (i == pos) ? theme->accent : COLOR_TEXT;
+    sprite.setTextColor(color, COLOR_BG);
+    sprite.setCursor(x, 50);
+    sprite.print(initials[i]);
+    if (i == pos) sprite.fillRect(x, 84, 24, 3, theme->accent);
+  }
+
+  sprite.setTextSize(1);
+  sprite.setTextColor(COLOR_DIM, COLOR_BG);
+  sprite.setCursor(5, 108);
+  sprite.print("[OK] +1  [A] -1  Hold to scroll");
+  sprite.setCursor(5, 118);
+  sprite.print(pos == MG_INITIALS - 1 ? "[B] Save" : "[B] Next letter");
+  endDraw();
+}
+
+void displayMgScores(const char* game, const MgScoreEntry* table, int8_t highlight) {
+  beginDraw();
+  drawCentered(game, 5, 2, theme->accent);
+
+  sprite.setTextSize(1);
+  for (uint8_t i = 0; i < MG_BOARD_SIZE; i++) {
+    int y = 30 + i * 15;
+    uint16_t bg = COLOR_BG;
+    if (i == highlight) {
+      bg = theme->selBg;
+      sprite.fillRoundRect(20, y - 3, SCREEN_W - 40, 14, 3, bg);
+    }
+    sprite.setTextColor(i == highlight ? theme->selText : COLOR_TEXT, bg);
+    char buf[32];
+    const MgScoreEntry& e = table[i];
+    if (e.score == 0) {
+      snprintf(buf, sizeof(buf), "%d.  ---", i + 1);
+    } else {
+      snprintf(buf, sizeof(buf), "%d.  %.3s  %5u  %2u:%02u", i + 1, e.initials, e.score, e.seconds / 60,
+               e.seconds % 60);
+    }
+    sprite.setCursor(35, y);
+    sprite.print(buf);
+  }
+
+  drawCentered("[A] Next game  [OK] Back", 118, 1, COLOR_DIM);
+  endDraw();
+}
+
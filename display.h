@@ -3,11 +3,19 @@
 
 #include "config.h"
 #include "game.h"
+#include "mgboard.h"
+#include "perf.h"
+#include "tilt.h"
 #include <M5Unified.h>
 
 M5Canvas& displayGetSprite();
 void displayBeginDraw(uint16_t bg = COLOR_BG);
 void displayEndDraw();
+void displayPushRect(int x, int y, int w, int h);
+void displaySetPerfOverlay(bool on);
+void displayPerfOverlay();
+void displayBlit(uint8_t spriteId, int x, int y);
+void displayInvalidate();
 void displayDrawCentered(const char* text, int y, uint8_t size, uint16_t color, uint16_t bg = COLOR_BG);
 const ColorTheme* displayGetTheme();
 
@@ -16,33 +24,43 @@ void displayInit();
 void displayStartup();
 void displayMainMenu(uint8_t selection);
 void displayGameModeSelect(uint8_t selection);
-void displayCustomLifeInput(uint8_t life);
+void displayCustomLifeInput(int16_t life);
+void displayPlayerCountSelect(uint8_t count);
 void displayPlayerThemeSelect(uint8_t playerIdx, ThemeId selectedTheme);
 void displayGame(const GameState& gs, TimerMode timerMode);
 void displayGameMenu(const GameState& gs, uint8_t selection);
+void displayCounters(const GameState& gs, uint8_t selection);
+void displayQuickEntry(const GameState& gs, int8_t sign, const uint8_t* digits, uint8_t field);
 void displayDice(const GameState& gs);
 void displayCoin(const GameState& gs);
 void displayConfirmReset(uint8_t selection);
 void displayGameOver(const GameState& gs, TimerMode timerMode);
+void displayTurnStats(const GameState& gs);
+void displayReplay(const GameState& gs, uint16_t position, uint16_t total, const MatchEvent* last, unsigned long elapsedDs);
 void displaySettings(uint8_t selection, uint8_t brightness, uint8_t volume, TimerMode timerMode, ThemeId themeId, bool faceDownPause, uint8_t shutdownIdleIdx, uint8_t shutdownGameIdx);
 void displayAbout();
 void displayDiagnostics(uint8_t selection, bool hasEasterEggs);
 void displayBatteryInfo();
 void displaySystemInfo();
+void displayPerf(const PerfStats& ps, const TiltStats& ts, bool overlay);
+void displayTelemetry(uint8_t channel, uint16_t intervalS, bool full);
 void displayGameStats(uint16_t totalMatches, uint32_t totalPlaytime,
-                      uint16_t p1Wins, uint16_t p2Wins,
+                      const uint16_t* playerWins,
                       uint16_t diceRolls, uint16_t coinFlips);
 void displayTemperature();
 void displayIMUStatus();
-void displayDiceAnimation(uint8_t sides);
-void displayCoinAnimation();
+void displayDiceAnimationFrame(uint8_t sides);
+void displayCoinAnimationFrame(uint8_t frame);
 void displayVictoryAnimation(uint8_t winnerIdx, const GameState& gs);
 void displayTestMenu(uint8_t selection);
 void displayIMUCalibration(bool inProgress, uint8_t samplesCollected, float magnitude);
 void displayButtonTest(bool btnA, bool btnB, bool btnPWR);
 void displayScreenTest(uint8_t pattern);
 void displaySpeakerTest(uint16_t frequency);
-void displayEasterEggsMenu(uint8_t selection);
-void displayMiniGameOver(uint16_t score);
+void displayBenchmark();
+void displayEasterEggsMenu(uint8_t selection, const char* mode);
+void displayMiniGameOver(uint16_t score, bool won = false);
+void displayMgInitials(const char* game, uint16_t score, uint8_t rank, const char* initials, uint8_t pos);
+void displayMgScores(const char* game, const MgScoreEntry* table, int8_t highlight);
 
 #endif
@@ -0,0 +1,52 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <stdint.h>
+
+// Fixed-capacity id allocator for minigame entities. Component data lives
+// in parallel arrays owned by the caller and indexed by id; the pool only
+// tracks which ids are live.
+//
+// dense[0, count) holds the live ids packed together for iteration, and
+// dense[count, CAPACITY) is the free list. spawn() pops the first free id
+// and kill() swaps the id with the last live one, both O(1). Ids stay
+// stable while alive, so they can be handed to SpatialGrid.
+//
+// Killing during iteration is safe when walking dense[] backwards: the id
+// swapped into the current position has already been visited.
+template <uint16_t CAPACITY>
+struct EntityPool {
+  uint16_t dense[CAPACITY];
+  uint16_t slot[CAPACITY];
+  uint16_t count;
+
+  void clear() {
+    count = 0;
+    for (uint16_t i = 0; i < CAPACITY; i++) {
+      dense[i] = i;
+      slot[i] = i;
+    }
+  }
+
+  // Returns the new id, or -1 when the pool is full.
+  int16_t spawn() {
+    if (count >= CAPACITY) return -1;
+    return dense[count++];
+  }
+
+  void kill(uint16_t id) {
+    uint16_t pos = slot[id];
+    if (pos >= count) return;
+    uint16_t last = dense[--count];
+    dense[pos] = last;
+    slot[last] = pos;
+    dense[count] = id;
+    slot[id] = count;
+  }
+
+  bool alive(uint16_t id) const {
+    return slot[id] < count;
+  }
+};
+
+#endif
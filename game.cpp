@@ -1,88 +1,255 @@
 #include "game.h"
+#include "satmath.h"
+#include "prng.h"
+#include "turntimer.h"
+
+#define MATCH_SNAPSHOT_COUNT (MATCH_LOG_SIZE / MATCH_SNAPSHOT_INTERVAL)
+
+static_assert(sizeof(MatchEvent) == 6, "MatchEvent must stay 6 bytes");
+static_assert(MATCH_LOG_SIZE % MATCH_SNAPSHOT_INTERVAL == 0, "log size must be a multiple of the snapshot interval");
+
+struct MatchLog {
+  MatchEvent events[MATCH_LOG_SIZE];
+  GameState snapshots[MATCH_SNAPSHOT_COUNT];
+  uint16_t count;
+  unsigned long lastEventMs;
+};
+
+static MatchLog matchLog;
+
+void gameInit(GameState& gs, int16_t startingLife, uint8_t playerCount, const ThemeId* themes) {
+  if (playerCount < MIN_PLAYERS) playerCount = MIN_PLAYERS;
+  if (playerCount > MAX_PLAYERS) playerCount = MAX_PLAYERS;
 
-void gameInit(GameState& gs, uint8_t startingLife) {
   gs.startingLife = startingLife;
+  gs.playerCount = playerCount;
+  gs.aliveMask = (1 << playerCount) - 1;
   gs.activePlayer = 0;
   gs.historyCount = 0;
   gs.appState = STATE_GAME;
   gs.menuSelection = 0;
   gs.gameOver = false;
-  gs.loserIndex = 0;
+  gs.winnerIndex = 0;
   gs.lastDiceResult = 0;
   gs.diceType = 20;
   gs.lastCoinResult = false;
   gs.showingResult = false;
-  gs.turnStartMs = millis();
-  gs.matchStartMs = millis();
+  turnTimerReset();
+  gs.turnStartMs = turnTimerNow();
+  gs.matchStartMs = gs.turnStartMs;
   gs.timerRunning = true;
 
   for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
-    gs.players[i].life = startingLife;
+    gs.players.life[i] = (i < playerCount) ? startingLife : 0;
+    gs.players.theme[i] = themes[i];
   }
+  countersClear(gs.counters);
   memset(gs.history, 0, sizeof(gs.history));
+
+  matchLog.count = 0;
+  matchLog.lastEventMs = gs.matchStartMs;
+  matchLog.snapshots[0] = gs;
 }
 
 void gameReset(GameState& gs) {
-  gameInit(gs, gs.startingLife);
+  ThemeId themes[MAX_PLAYERS];
+  memcpy(themes, gs.players.theme, sizeof(themes));
+  gameInit(gs, gs.startingLife, gs.playerCount, themes);
+}
+
+static void advanceActivePlayer(GameState& gs) {
+  for (uint8_t i = 1; i <= gs.playerCount; i++) {
+    uint8_t next = (gs.activePlayer + i) % gs.playerCount;
+    if (gameIsAlive(gs, next)) {
+      gs.activePlayer = next;
+      return;
+    }
+  }
+}
+
+static void settleDefeats(GameState& gs) {
+  if (gameAliveCount(gs) <= 1) {
+    gs.gameOver = true;
+    gs.winnerIndex = gs.aliveMask ? __builtin_ctz(gs.aliveMask) : gs.activePlayer;
+    gs.timerRunning = false;
+  } else if (!gameIsAlive(gs, gs.activePlayer)) {
+    advanceActivePlayer(gs);
+  }
+}
+
+static void eliminatePlayer(GameState& gs, uint8_t playerIndex) {
+  gs.aliveMask &= ~(1 << playerIndex);
+  settleDefeats(gs);
 }
 
-static void pushHistory(GameState& gs, int8_t playerIndex, int8_t delta) {
+static void pushHistory(GameState& gs, uint8_t playerIndex, uint8_t slot, int16_t delta) {
   if (gs.historyCount >= HISTORY_SIZE) {
     memmove(&gs.history[0], &gs.history[1], sizeof(HistoryEntry) * (HISTORY_SIZE - 1));
     gs.historyCount = HISTORY_SIZE - 1;
   }
   gs.history[gs.historyCount].playerIndex = playerIndex;
+  gs.history[gs.historyCount].slot = slot;
   gs.history[gs.historyCount].delta = delta;
   gs.historyCount++;
 }
 
-void gameAddLife(GameState& gs, int8_t playerIndex, int8_t delta) {
-  if (gs.gameOver) return;
+static void foldLife(GameState& gs, uint8_t playerIndex, int16_t delta) {
+  int16_t& life = gs.players.life[playerIndex];
+  life = satAdd<int16_t>(life, delta, LIFE_FLOOR, LIFE_CEIL);
+
+  pushHistory(gs, playerIndex, HISTORY_LIFE, delta);
+  if (life <= 0) {
+    eliminatePlayer(gs, playerIndex);
+  }
+}
 
-  int16_t newLife = (int16_t)gs.players[playerIndex].life + delta;
+static void foldCounter(GameState& gs, uint8_t playerIndex, uint8_t slot, int16_t delta) {
+  int16_t before = counterGet(gs.counters, playerIndex, slot);
+  bool lethal = counterAdd(gs.counters, playerIndex, slot, delta);
 
-  if (newLife > 255) {
-    gs.players[playerIndex].life = 255;
-  } else if (newLife < 0) {
-    gs.players[playerIndex].life = 0;
-  } else {
-    gs.players[playerIndex].life = (uint8_t)newLife;
+  // Commander damage is also life loss, so it moves the life total too,
+  // by the change the counter actually took after clamping.
+  if (slot >= COUNTER_CMDR_BASE) {
+    int16_t applied = counterGet(gs.counters, playerIndex, slot) - before;
+    int16_t& life = gs.players.life[playerIndex];
+    life = satSub<int16_t>(life, applied, LIFE_FLOOR, LIFE_CEIL);
+    if (life <= 0) lethal = true;
   }
 
-  pushHistory(gs, playerIndex, delta);
-  gameCheckDefeat(gs);
+  pushHistory(gs, playerIndex, slot, delta);
+  if (lethal) {
+    eliminatePlayer(gs, playerIndex);
+  }
 }
 
-void gameCheckDefeat(GameState& gs) {
-  for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
-    if (gs.players[i].life == 0) {
-      gs.gameOver = true;
-      gs.loserIndex = i;
-      gs.timerRunning = false;
-      return;
-    }
+static void foldEvent(GameState& gs, const MatchEvent& ev) {
+  switch (ev.type) {
+    case EVT_LIFE:    foldLife(gs, ev.player, ev.value);             break;
+    case EVT_COUNTER: foldCounter(gs, ev.player, ev.arg, ev.value);  break;
+    case EVT_SWITCH:  advanceActivePlayer(gs);                       break;
+    case EVT_DICE:
+      gs.diceType = ev.arg;
+      gs.lastDiceResult = (uint8_t)ev.value;
+      break;
+    case EVT_COIN:
+      gs.lastCoinResult = ev.value != 0;
+      break;
+    case EVT_TIMEOUT:
+      if (gameIsAlive(gs, ev.player)) eliminatePlayer(gs, ev.player);
+      break;
+  }
+}
+
+static void rebaseLog() {
+  memmove(&matchLog.events[0], &matchLog.events[MATCH_SNAPSHOT_INTERVAL],
+          sizeof(MatchEvent) * (MATCH_LOG_SIZE - MATCH_SNAPSHOT_INTERVAL));
+  memmove(&matchLog.snapshots[0], &matchLog.snapshots[1],
+          sizeof(GameState) * (MATCH_SNAPSHOT_COUNT - 1));
+  matchLog.count -= MATCH_SNAPSHOT_INTERVAL;
+}
+
+static void recordEvent(GameState& gs, uint8_t type, uint8_t player, uint8_t arg, int16_t value) {
+  unsigned long now = turnTimerNow();
+  unsigned long dtDs = (now - matchLog.lastEventMs) / 100;
+  matchLog.lastEventMs += dtDs * 100;
+
+  MatchEvent ev;
+  ev.type = type;
+  ev.player = player;
+  ev.arg = arg;
+  ev.value = value;
+  ev.dtDs = (dtDs > 0xFFFF) ? 0xFFFF : (uint16_t)dtDs;
+
+  if (matchLog.count == MATCH_LOG_SIZE) {
+    rebaseLog();
+  }
+  if (matchLog.count % MATCH_SNAPSHOT_INTERVAL == 0) {
+    matchLog.snapshots[matchLog.count / MATCH_SNAPSHOT_INTERVAL] = gs;
+  }
+  matchLog.events[matchLog.count++] = ev;
+
+  uint8_t activeBefore = gs.activePlayer;
+  bool overBefore = gs.gameOver;
+  foldEvent(gs, ev);
+  if (gs.activePlayer != activeBefore || gs.gameOver != overBefore) {
+    turnTimerEndTurn(activeBefore, now - gs.turnStartMs);
+    gs.turnStartMs = now;
   }
+  if (gs.gameOver && !overBefore) {
+    turnTimerPause();
+  }
+}
+
+void gameAddLife(GameState& gs, uint8_t playerIndex, int16_t delta) {
+  if (gs.gameOver) return;
+  recordEvent(gs, EVT_LIFE, playerIndex, 0, delta);
+}
+
+void gameAddCounter(GameState& gs, uint8_t playerIndex, uint8_t slot, int16_t delta) {
+  if (gs.gameOver || !gameIsAlive(gs, playerIndex)) return;
+  recordEvent(gs, EVT_COUNTER, playerIndex, slot, delta);
 }
 
 uint8_t gameRollDice(GameState& gs, uint8_t sides) {
-  gs.diceType = sides;
-  gs.lastDiceResult = random(1, sides + 1);
+  recordEvent(gs, EVT_DICE, gs.activePlayer, sides, prngRange(PRNG_DICE, 1, sides + 1));
   gs.showingResult = true;
   return gs.lastDiceResult;
 }
 
 bool gameFlipCoin(GameState& gs) {
-  gs.lastCoinResult = random(0, 2) == 1;
+  recordEvent(gs, EVT_COIN, gs.activePlayer, 0, prngBelow(PRNG_COIN, 2));
   gs.showingResult = true;
   return gs.lastCoinResult;
 }
 
 void gameSwitchPlayer(GameState& gs) {
-  gs.activePlayer = (gs.activePlayer + 1) % MAX_PLAYERS;
-  gs.turnStartMs = millis();
+  if (gs.gameOver) return;
+  recordEvent(gs, EVT_SWITCH, gs.activePlayer, 0, 0);
+}
+
+void gameFlagFall(GameState& gs, uint8_t playerIndex) {
+  if (gs.gameOver || !gameIsAlive(gs, playerIndex)) return;
+  recordEvent(gs, EVT_TIMEOUT, playerIndex, 0, 0);
 }
 
 unsigned long gameGetMatchSeconds(const GameState& gs) {
+  return (turnTimerNow() - gs.matchStartMs) / 1000;
+}
+
+unsigned long gameGetTurnMs(const GameState& gs) {
   if (!gs.timerRunning) return 0;
-  return (millis() - gs.matchStartMs) / 1000;
+  return turnTimerNow() - gs.turnStartMs;
+}
+
+unsigned long gameBankRemainingMs(const GameState& gs, uint8_t playerIndex) {
+  unsigned long running = (playerIndex == gs.activePlayer) ? gameGetTurnMs(gs) : 0;
+  return turnTimerBankMs(playerIndex, running);
+}
+
+bool gameIsAlive(const GameState& gs, uint8_t playerIndex) {
+  return (gs.aliveMask >> playerIndex) & 1;
+}
+
+uint8_t gameAliveCount(const GameState& gs) {
+  return __builtin_popcount(gs.aliveMask);
+}
+
+uint16_t gameEventCount() {
+  return matchLog.count;
+}
+
+const MatchEvent* gameEvents() {
+  return matchLog.events;
+}
+
+void gameReplay(GameState& out, uint16_t eventCount) {
+  if (eventCount > matchLog.count) eventCount = matchLog.count;
+
+  uint16_t snap = eventCount / MATCH_SNAPSHOT_INTERVAL;
+  if (snap > 0 && snap * MATCH_SNAPSHOT_INTERVAL >= matchLog.count) snap--;
+
+  out = matchLog.snapshots[snap];
+  for (uint16_t i = snap * MATCH_SNAPSHOT_INTERVAL; i < eventCount; i++) {
+    foldEvent(out, matchLog.events[i]);
+  }
 }
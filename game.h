@@ -2,28 +2,57 @@
 #define GAME_H
 
 #include "config.h"
+#include "counters.h"
 #include <Arduino.h>
 
+#define HISTORY_LIFE 0xFF
+
 struct HistoryEntry {
   int8_t playerIndex;
-  int8_t delta;
+  uint8_t slot;
+  int16_t delta;
+};
+
+struct PlayerTable {
+  int16_t life[MAX_PLAYERS];
+  ThemeId theme[MAX_PLAYERS];
+};
+
+// A match is its genesis state (starting life, player count, themes) plus
+// an append-only stream of MatchEvents; GameState is the fold of that
+// stream. The same genesis + events always reproduce the same state, which
+// makes a recorded log a deterministic test vector for the game rules.
+enum MatchEventType {
+  EVT_LIFE,
+  EVT_COUNTER,
+  EVT_SWITCH,
+  EVT_DICE,
+  EVT_COIN,
+  EVT_TIMEOUT,
+  EVT_TYPE_COUNT
 };
 
-struct Player {
-  uint8_t life;
-  ThemeId theme;
+struct MatchEvent {
+  uint8_t type : 4;
+  uint8_t player : 4;
+  uint8_t arg;
+  int16_t value;
+  uint16_t dtDs;
 };
 
 struct GameState {
-  Player players[MAX_PLAYERS];
+  PlayerTable players;
+  CounterStore counters;
+  uint8_t playerCount;
+  uint8_t aliveMask;
   HistoryEntry history[HISTORY_SIZE];
   uint8_t historyCount;
   uint8_t activePlayer;
-  uint8_t startingLife;
+  int16_t startingLife;
   AppState appState;
   uint8_t menuSelection;
   bool gameOver;
-  uint8_t loserIndex;
+  uint8_t winnerIndex;
   uint8_t lastDiceResult;
   uint8_t diceType;
   bool lastCoinResult;
@@ -33,13 +62,21 @@ struct GameState {
   bool timerRunning;
 };
 
-void gameInit(GameState& gs, uint8_t startingLife);
+void gameInit(GameState& gs, int16_t startingLife, uint8_t playerCount, const ThemeId* themes);
 void gameReset(GameState& gs);
-void gameAddLife(GameState& gs, int8_t playerIndex, int8_t delta);
-void gameCheckDefeat(GameState& gs);
+void gameAddLife(GameState& gs, uint8_t playerIndex, int16_t delta);
+void gameAddCounter(GameState& gs, uint8_t playerIndex, uint8_t slot, int16_t delta);
 uint8_t gameRollDice(GameState& gs, uint8_t sides);
 bool gameFlipCoin(GameState& gs);
 void gameSwitchPlayer(GameState& gs);
 unsigned long gameGetMatchSeconds(const GameState& gs);
+unsigned long gameGetTurnMs(const GameState& gs);
+unsigned long gameBankRemainingMs(const GameState& gs, uint8_t playerIndex);
+void gameFlagFall(GameState& gs, uint8_t playerIndex);
+bool gameIsAlive(const GameState& gs, uint8_t playerIndex);
+uint8_t gameAliveCount(const GameState& gs);
+uint16_t gameEventCount();
+const MatchEvent* gameEvents();
+void gameReplay(GameState& out, uint16_t eventCount);
 
 #endif
@@ -1,4 +1,6 @@
 #include "input.h"
+#include "tilt.h"
+#include "perf.h"
 #include <M5Unified.h>
 #include <math.h>
 
@@ -39,17 +41,21 @@ InputEvent inputUpdate(InputState& is) {
     return INPUT_PWR;
   }
 
-  M5.Imu.update();
-  m5::imu_data_t imuData;
-  M5.Imu.getImuData(&imuData);
-  float mag = sqrtf(imuData.accel.x * imuData.accel.x +
-                    imuData.accel.y * imuData.accel.y +
-                    imuData.accel.z * imuData.accel.z);
+  // While tilt control runs, its task owns the IMU.
+  if (!tiltActive()) {
+    M5.Imu.update();
+    m5::imu_data_t imuData;
+    M5.Imu.getImuData(&imuData);
+    perfCountI2C();
+    float mag = sqrtf(imuData.accel.x * imuData.accel.x +
+                      imuData.accel.y * imuData.accel.y +
+                      imuData.accel.z * imuData.accel.z);
 
-  float deviation = fabsf(mag - is.baselineMag);
-  if (deviation > SHAKE_THRESHOLD && (now - is.lastShakeMs) > SHAKE_COOLDOWN_MS) {
-    is.lastShakeMs = now;
-    return INPUT_SHAKE;
+    float deviation = fabsf(mag - is.baselineMag);
+    if (deviation > SHAKE_THRESHOLD && (now - is.lastShakeMs) > SHAKE_COOLDOWN_MS) {
+      is.lastShakeMs = now;
+      return INPUT_SHAKE;
+    }
   }
 
   if (M5.BtnA.wasPressed()) {
@@ -1,39 +1,183 @@
 #include "joystick.h"
+#include "perf.h"
+#include <Arduino.h>
 #include <Wire.h>
+#include <math.h>
 
-void joystickInit() {
-  Wire.begin(0, 26, 100000);
-}
+// Once started, the poll task owns the bus. It reads the HAT every
+// JOYSTICK_POLL_MS (JOYSTICK_IDLE_POLL_MS while nothing answers), shapes
+// the sample into the back slot and then flips front. Readers copy the
+// front slot under a spinlock held only for the copy, so the game loop
+// never waits on I2C.
+static JoystickState slots[2];
+static volatile uint8_t front = 0;
+static volatile uint32_t sampleCount = 0;
+static portMUX_TYPE slotLock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t pollTask = nullptr;
+static JoystickStats stats;
 
-bool joystickDetect() {
-  Wire.beginTransmission(JOYSTICK_I2C_ADDR);
-  return (Wire.endTransmission() == 0);
-}
+struct JoystickCal {
+  float cx, cy;
+  float minX, maxX, minY, maxY;
+  int32_t sumX, sumY;
+  uint8_t samples;
+};
 
-void joystickRead(JoystickState& js) {
+static JoystickCal cal;
+static bool calPending = true;
+static volatile bool calRestart = false;
+static volatile uint8_t deadzonePct = JOYSTICK_DEADZONE_PCT;
+static volatile JoystickCurve curve = JOYSTICK_CURVE_SQUARE;
+
+static bool busRead(JoystickState& js) {
   Wire.beginTransmission(JOYSTICK_I2C_ADDR);
   Wire.write(JOYSTICK_REG_CONVERTED);
   Wire.endTransmission(false);
 
   Wire.requestFrom((int)JOYSTICK_I2C_ADDR, 3);
-  if (Wire.available() >= 3) {
-    js.x = (int8_t)Wire.read();
-    js.y = (int8_t)Wire.read();
-    js.button = (Wire.read() == 0);
-    js.connected = true;
-  } else {
-    js.connected = false;
+  perfCountI2C(2);
+  if (Wire.available() < 3) return false;
+  js.x = (int8_t)Wire.read();
+  js.y = (int8_t)Wire.read();
+  js.button = (Wire.read() == 0);
+  return true;
+}
+
+// Averages resting samples into the centre. A sample far off centre means
+// the stick is being held, so averaging starts over.
+static bool calibrate(const JoystickState& js) {
+  if (abs(js.x) > JOYSTICK_CAL_MAX_OFFSET || abs(js.y) > JOYSTICK_CAL_MAX_OFFSET) {
+    cal.samples = 0;
+    cal.sumX = cal.sumY = 0;
+    return false;
+  }
+  cal.sumX += js.x;
+  cal.sumY += js.y;
+  if (++cal.samples < JOYSTICK_CAL_SAMPLES) return false;
+
+  cal.cx = (float)cal.sumX / cal.samples;
+  cal.cy = (float)cal.sumY / cal.samples;
+  cal.minX = cal.minY = -JOYSTICK_RAW_RANGE;
+  cal.maxX = cal.maxY = JOYSTICK_RAW_RANGE;
+  calPending = false;
+  return true;
+}
+
+// Offset from the centre as a fraction of the furthest travel seen on that
+// side, so a stick that never reaches the nominal range still hits 1.
+static float normAxis(float d, float& lo, float& hi) {
+  if (d > hi) hi = d;
+  if (d < lo) lo = d;
+  return (d >= 0) ? d / hi : -d / lo;
+}
+
+static int8_t quantize(float v, int8_t prev) {
+  float target = v * JOYSTICK_AXIS_STEPS;
+  if (fabsf(target - prev) < 0.5f + JOYSTICK_HYSTERESIS) return prev;
+  return (int8_t)lroundf(target);
+}
+
+void joystickShape(float nx, float ny, JoystickState& js) {
+  float mag = sqrtf(nx * nx + ny * ny);
+  float dz = deadzonePct / 100.0f;
+  if (mag <= dz) {
+    js.ax = js.ay = 0;
+    return;
+  }
+
+  float r = (mag >= 1.0f) ? 1.0f : (mag - dz) / (1.0f - dz);
+  switch (curve) {
+    case JOYSTICK_CURVE_SQUARE: r = r * r;     break;
+    case JOYSTICK_CURVE_CUBIC:  r = r * r * r; break;
+    default:                                   break;
   }
+  float scale = r / mag;
+  js.ax = quantize(nx * scale, js.ax);
+  js.ay = quantize(ny * scale, js.ay);
+}
+
+static void shape(JoystickState& js) {
+  float nx = normAxis(js.x - cal.cx, cal.minX, cal.maxX);
+  float ny = normAxis(js.y - cal.cy, cal.minY, cal.maxY);
+  joystickShape(-ny, -nx, js);
+}
+
+static void joystickTask(void*) {
+  uint8_t back = 1;
+  TickType_t wake = xTaskGetTickCount();
+
+  for (;;) {
+    const JoystickState& prev = slots[front];
+    JoystickState& js = slots[back];
+    js = prev;
+    if (calRestart) {
+      calRestart = false;
+      cal.samples = 0;
+      cal.sumX = cal.sumY = 0;
+      calPending = true;
+    }
+    unsigned long t0 = micros();
+    js.connected = busRead(js);
+    uint16_t us = micros() - t0;
+    stats.lastUs = us;
+    if (us > stats.maxUs) stats.maxUs = us;
+    stats.busUsTotal += us;
+    stats.samples++;
+    if (!js.connected || (calPending && !calibrate(js))) {
+      js.ax = js.ay = 0;
+    } else {
+      shape(js);
+    }
+
+    portENTER_CRITICAL(&slotLock);
+    front = back;
+    portEXIT_CRITICAL(&slotLock);
+    back ^= 1;
+    sampleCount++;
+
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(js.connected ? JOYSTICK_POLL_MS : JOYSTICK_IDLE_POLL_MS));
+  }
+}
+
+void joystickInit() {
+  if (pollTask) return;
+  Wire.begin(0, 26, JOYSTICK_I2C_HZ);
+  xTaskCreate(joystickTask, "joystick", JOYSTICK_TASK_STACK, nullptr, JOYSTICK_TASK_PRIORITY, &pollTask);
+  perfWatchTask(pollTask, "joy");
+}
+
+// Waits for a fresh sample from the poll task instead of probing the bus
+// from a second task.
+bool joystickDetect() {
+  if (!pollTask) return false;
+  uint32_t start = sampleCount;
+  unsigned long t0 = millis();
+  while (sampleCount - start < 2 && millis() - t0 < 3 * JOYSTICK_IDLE_POLL_MS) delay(1);
+  JoystickState js;
+  joystickRead(js);
+  return js.connected;
+}
+
+void joystickRead(JoystickState& js) {
+  portENTER_CRITICAL(&slotLock);
+  js = slots[front];
+  portEXIT_CRITICAL(&slotLock);
+}
+
+void joystickSetResponse(uint8_t dzPct, JoystickCurve c) {
+  deadzonePct = (dzPct > 90) ? 90 : dzPct;
+  curve = c;
 }
 
-int8_t joystickDirX(const JoystickState& js) {
-  if (js.y > JOYSTICK_DEADZONE) return -1;
-  if (js.y < -JOYSTICK_DEADZONE) return 1;
-  return 0;
+void joystickRecalibrate() {
+  calRestart = true;
 }
 
-int8_t joystickDirY(const JoystickState& js) {
-  if (js.x > JOYSTICK_DEADZONE) return -1;
-  if (js.x < -JOYSTICK_DEADZONE) return 1;
-  return 0;
+JoystickStats joystickGetStats() {
+  JoystickStats s;
+  s.samples = stats.samples;
+  s.busUsTotal = stats.busUsTotal;
+  s.lastUs = stats.lastUs;
+  s.maxUs = stats.maxUs;
+  return s;
 }
@@ -5,19 +5,78 @@
 
 #define JOYSTICK_I2C_ADDR  0x38
 #define JOYSTICK_REG_CONVERTED  0x02
-#define JOYSTICK_DEADZONE  40
+#define JOYSTICK_I2C_HZ    400000
 
+#define JOYSTICK_POLL_MS        5
+#define JOYSTICK_IDLE_POLL_MS   100
+#define JOYSTICK_TASK_STACK     3072
+#define JOYSTICK_TASK_PRIORITY  1
+#define JOYSTICK_CAL_SAMPLES    16
+#define JOYSTICK_CAL_MAX_OFFSET 30
+#define JOYSTICK_RAW_RANGE      100
+
+// Shaped axes are quantized to whole steps so a run can be recorded and
+// replayed exactly; the hysteresis (in steps) stops a stick resting on a
+// boundary from flickering between two of them.
+#define JOYSTICK_AXIS_STEPS     4
+#define JOYSTICK_HYSTERESIS     0.15f
+#define JOYSTICK_DEADZONE_PCT   30
+
+enum JoystickCurve : uint8_t {
+  JOYSTICK_CURVE_LINEAR,
+  JOYSTICK_CURVE_SQUARE,
+  JOYSTICK_CURVE_CUBIC
+};
+
+// x/y are the raw HAT axes. ax/ay are the screen axes (the unit is mounted
+// rotated, so screen X follows the stick's Y axis) after centre
+// calibration, the radial deadzone and the response curve, in
+// -JOYSTICK_AXIS_STEPS..JOYSTICK_AXIS_STEPS.
 struct JoystickState {
   int8_t x;
   int8_t y;
+  int8_t ax;
+  int8_t ay;
   bool button;
   bool connected;
 };
 
+// Bus time of the poll task's reads, including ones nothing answered.
+struct JoystickStats {
+  uint32_t samples;
+  uint32_t busUsTotal;
+  uint16_t lastUs;
+  uint16_t maxUs;
+};
+
+// Starts the bus and the background poll task; safe to call again.
 void joystickInit();
 bool joystickDetect();
+// Copies the latest sample. Never touches the bus.
 void joystickRead(JoystickState& js);
-int8_t joystickDirX(const JoystickState& js);
-int8_t joystickDirY(const JoystickState& js);
+void joystickSetResponse(uint8_t deadzonePct, JoystickCurve curve);
+// Applies the deadzone, curve and quantization to a screen-axis vector
+// (1 = full deflection), updating js.ax/js.ay with hysteresis against
+// their current values. Shared with the tilt controller.
+void joystickShape(float sx, float sy, JoystickState& js);
+// Re-learns the centre from the next JOYSTICK_CAL_SAMPLES resting samples.
+void joystickRecalibrate();
+JoystickStats joystickGetStats();
+
+static inline int8_t joystickDirX(const JoystickState& js) {
+  return (js.ax > 0) - (js.ax < 0);
+}
+
+static inline int8_t joystickDirY(const JoystickState& js) {
+  return (js.ay > 0) - (js.ay < 0);
+}
+
+static inline float joystickAxisX(const JoystickState& js) {
+  return js.ax * (1.0f / JOYSTICK_AXIS_STEPS);
+}
+
+static inline float joystickAxisY(const JoystickState& js) {
+  return js.ay * (1.0f / JOYSTICK_AXIS_STEPS);
+}
 
 #endif
@@ -0,0 +1,86 @@
+#include "mahony.h"
+
+static inline int32_t qmul(int32_t a, int32_t b) {
+  return (int32_t)(((int64_t)a * b) >> MAHONY_Q);
+}
+
+// Bit-by-bit square root; 32 fixed iterations.
+static uint32_t isqrt64(uint64_t n) {
+  uint64_t root = 0;
+  uint64_t bit = 1ULL << 62;
+  for (uint8_t i = 0; i < 32; i++) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
+
+void mahonyInit(MahonyState& s, float sampleHz, float kp, float kpWarm, float ki) {
+  float halfDt = 0.5f / sampleHz;
+  s.q[0] = MAHONY_ONE;
+  s.q[1] = s.q[2] = s.q[3] = 0;
+  s.bias[0] = s.bias[1] = s.bias[2] = 0;
+  s.halfDt = (int32_t)(halfDt * MAHONY_ONE);
+  s.kpTerm = (int32_t)(kp * halfDt * MAHONY_ONE);
+  s.kpWarmTerm = (int32_t)(kpWarm * halfDt * MAHONY_ONE);
+  s.kiTerm = (int32_t)(ki * halfDt * 2.0f * halfDt * MAHONY_ONE);
+  s.samples = 0;
+}
+
+void mahonyGravity(const MahonyState& s, int32_t v[3]) {
+  const int32_t* q = s.q;
+  v[0] = 2 * (qmul(q[1], q[3]) - qmul(q[0], q[2]));
+  v[1] = 2 * (qmul(q[0], q[1]) + qmul(q[2], q[3]));
+  v[2] = qmul(q[0], q[0]) - qmul(q[1], q[1]) - qmul(q[2], q[2]) + qmul(q[3], q[3]);
+}
+
+// All rates are carried as half-angle per sample (rate * dt / 2), which
+// keeps them well inside Q30 and turns the quaternion derivative into
+// plain multiply-adds.
+void mahonyUpdate(MahonyState& s, const int32_t gyro[3], const int32_t accel[3]) {
+  int32_t h[3];
+  for (uint8_t i = 0; i < 3; i++) h[i] = (int32_t)(((int64_t)gyro[i] * s.halfDt) >> MAHONY_IN_Q);
+
+  int64_t n2 = (int64_t)accel[0] * accel[0] + (int64_t)accel[1] * accel[1] + (int64_t)accel[2] * accel[2];
+  uint32_t n = isqrt64((uint64_t)n2);
+  if (n > 0) {
+    // One divide for the reciprocal; |accel[i]| <= n keeps the products
+    // inside 64 bits.
+    int64_t inv = (int64_t)((1ULL << (MAHONY_Q + MAHONY_IN_Q)) / n);
+    int32_t a[3];
+    for (uint8_t i = 0; i < 3; i++) a[i] = (int32_t)(((int64_t)accel[i] * inv) >> MAHONY_IN_Q);
+
+    int32_t v[3];
+    mahonyGravity(s, v);
+    int32_t e[3] = {
+      qmul(a[1], v[2]) - qmul(a[2], v[1]),
+      qmul(a[2], v[0]) - qmul(a[0], v[2]),
+      qmul(a[0], v[1]) - qmul(a[1], v[0])
+    };
+
+    int32_t kp = (s.samples < MAHONY_WARMUP) ? s.kpWarmTerm : s.kpTerm;
+    for (uint8_t i = 0; i < 3; i++) {
+      s.bias[i] += qmul(s.kiTerm, e[i]);
+      h[i] += qmul(kp, e[i]) + s.bias[i];
+    }
+  }
+  if (s.samples < MAHONY_WARMUP) s.samples++;
+
+  int32_t* q = s.q;
+  int32_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+  q[0] = q0 - qmul(q1, h[0]) - qmul(q2, h[1]) - qmul(q3, h[2]);
+  q[1] = q1 + qmul(q0, h[0]) + qmul(q2, h[2]) - qmul(q3, h[1]);
+  q[2] = q2 + qmul(q0, h[1]) - qmul(q1, h[2]) + qmul(q3, h[0]);
+  q[3] = q3 + qmul(q0, h[2]) + qmul(q1, h[1]) - qmul(q2, h[0]);
+
+  // |q| stays within a hair of 1, so one Newton step of 1/sqrt around 1
+  // renormalises it without a divide.
+  int64_t m2 = (int64_t)qmul(q[0], q[0]) + qmul(q[1], q[1]) + qmul(q[2], q[2]) + qmul(q[3], q[3]);
+  int32_t scale = (int32_t)((3LL * MAHONY_ONE - m2) / 2);
+  for (uint8_t i = 0; i < 4; i++) q[i] = qmul(q[i], scale);
+}
@@ -0,0 +1,35 @@
+#ifndef MAHONY_H
+#define MAHONY_H
+
+#include <stdint.h>
+
+// Mahony attitude filter (gyro + accelerometer, no magnetometer) in fixed
+// point. The quaternion, gains and gravity estimate are Q30; inputs are
+// Q16 (gyro in rad/s, accelerometer in any consistent unit, since it is
+// normalised). Every update runs the same instructions whatever the input,
+// so its cost is constant. No Arduino dependencies, so the host bench can
+// check it against a float reference.
+#define MAHONY_Q       30
+#define MAHONY_ONE     (1L << MAHONY_Q)
+#define MAHONY_IN_Q    16
+#define MAHONY_WARMUP  100
+
+struct MahonyState {
+  int32_t q[4];
+  int32_t bias[3];
+  int32_t halfDt;
+  int32_t kpTerm;
+  int32_t kpWarmTerm;
+  int32_t kiTerm;
+  uint16_t samples;
+};
+
+// The first MAHONY_WARMUP samples use kpWarm so the estimate snaps to the
+// measured gravity instead of converging slowly from level.
+void mahonyInit(MahonyState& s, float sampleHz, float kp, float kpWarm, float ki);
+void mahonyUpdate(MahonyState& s, const int32_t gyro[3], const int32_t accel[3]);
+// Unit gravity ("up", as the accelerometer reads it at rest) in the body
+// frame, Q30.
+void mahonyGravity(const MahonyState& s, int32_t v[3]);
+
+#endif
@@ -0,0 +1,65 @@
+// Generated by tools/melodyc.py from melodies/*.mel. Do not edit.
+#ifndef MELODIES_H
+#define MELODIES_H
+
+#include <Arduino.h>
+
+#define MEL_END     0x80
+#define MEL_TEMPO   0x81
+#define MEL_GAP     0x82
+#define MEL_LOOP    0x83
+#define MEL_ENDLOOP 0x84
+#define MEL_HZ      0x85
+
+static const uint8_t MEL_COIN_FLIP[] PROGMEM = {  // 19 bytes
+  0x81, 0x0A, 0x82, 0x02, 0x85, 0x02, 0x58, 0x08, 0x85, 0x03, 0x20, 0x08,
+  0x82, 0x00, 0x85, 0x03, 0xE8, 0x0A, 0x80,
+};
+
+static const uint8_t MEL_DEFEAT[] PROGMEM = {  // 15 bytes
+  0x81, 0x0A, 0x82, 0x02, 0x45, 0x16, 0x42, 0x16, 0x40, 0x16, 0x82, 0x00,
+  0x32, 0x28, 0x80,
+};
+
+static const uint8_t MEL_DICE_ROLL[] PROGMEM = {  // 31 bytes
+  0x81, 0x0A, 0x82, 0x01, 0x85, 0x03, 0x20, 0x05, 0x85, 0x03, 0x84, 0x05,
+  0x85, 0x03, 0xE8, 0x05, 0x85, 0x04, 0x4C, 0x05, 0x85, 0x04, 0xB0, 0x05,
+  0x82, 0x00, 0x85, 0x04, 0xB0, 0x0F, 0x80,
+};
+
+static const uint8_t MEL_GAME_OVER[] PROGMEM = {  // 13 bytes
+  0x81, 0x0A, 0x82, 0x02, 0x43, 0x11, 0x40, 0x11, 0x82, 0x00, 0x3C, 0x1E,
+  0x80,
+};
+
+static const uint8_t MEL_STARTUP[] PROGMEM = {  // 15 bytes
+  0x81, 0x0A, 0x82, 0x02, 0x48, 0x0A, 0x4C, 0x0A, 0x4F, 0x0A, 0x82, 0x00,
+  0x54, 0x0F, 0x80,
+};
+
+static const uint8_t MEL_VICTORY_FOREST[] PROGMEM = {  // 17 bytes
+  0x81, 0x0A, 0x82, 0x02, 0x4A, 0x0C, 0x4C, 0x0C, 0x4F, 0x0C, 0x51, 0x0C,
+  0x82, 0x00, 0x56, 0x22, 0x80,
+};
+
+static const uint8_t MEL_VICTORY_ISLAND[] PROGMEM = {  // 18 bytes
+  0x81, 0x0A, 0x82, 0x01, 0x83, 0x03, 0x4C, 0x07, 0x53, 0x07, 0x84, 0x50,
+  0x0A, 0x82, 0x00, 0x58, 0x1E, 0x80,
+};
+
+static const uint8_t MEL_VICTORY_MOUNTAIN[] PROGMEM = {  // 21 bytes
+  0x81, 0x08, 0x82, 0x02, 0x83, 0x03, 0x4F, 0x06, 0x84, 0x00, 0x04, 0x83,
+  0x02, 0x52, 0x06, 0x84, 0x82, 0x00, 0x54, 0x28, 0x80,
+};
+
+static const uint8_t MEL_VICTORY_PLAINS[] PROGMEM = {  // 17 bytes
+  0x81, 0x0A, 0x82, 0x02, 0x48, 0x0E, 0x4C, 0x0E, 0x4F, 0x0E, 0x54, 0x20,
+  0x82, 0x00, 0x54, 0x14, 0x80,
+};
+
+static const uint8_t MEL_VICTORY_SWAMP[] PROGMEM = {  // 21 bytes
+  0x81, 0x0C, 0x82, 0x02, 0x45, 0x0C, 0x48, 0x0C, 0x4C, 0x0C, 0x50, 0x0C,
+  0x82, 0x00, 0x51, 0x10, 0x00, 0x04, 0x45, 0x1E, 0x80,
+};
+
+#endif
@@ -0,0 +1,30 @@
+#include "mgboard.h"
+#include <string.h>
+
+void mgBoardReset(MgLeaderboard& board) {
+  memset(&board, 0, sizeof(board));
+  board.version = MG_BOARD_VERSION;
+  memset(board.lastInitials, 'A', MG_INITIALS);
+}
+
+bool mgBoardValid(const MgLeaderboard& board, size_t blobBytes) {
+  return blobBytes == sizeof(board) && board.version == MG_BOARD_VERSION;
+}
+
+int8_t mgBoardRank(const MgLeaderboard& board, uint8_t game, uint16_t score) {
+  if (game >= MINIGAME_COUNT || score == 0) return -1;
+  const MgScoreEntry* table = board.entries[game];
+  for (uint8_t i = 0; i < MG_BOARD_SIZE; i++) {
+    if (score > table[i].score) return i;
+  }
+  return -1;
+}
+
+int8_t mgBoardInsert(MgLeaderboard& board, uint8_t game, const MgScoreEntry& entry) {
+  int8_t rank = mgBoardRank(board, game, entry.score);
+  if (rank < 0) return -1;
+  MgScoreEntry* table = board.entries[game];
+  memmove(&table[rank + 1], &table[rank], (MG_BOARD_SIZE - 1 - rank) * sizeof(MgScoreEntry));
+  table[rank] = entry;
+  return rank;
+}
@@ -0,0 +1,39 @@
+#ifndef MGBOARD_H
+#define MGBOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "minigames.h"
+
+// Top MG_BOARD_SIZE scores of every minigame in one fixed-layout block,
+// stored as a single Preferences blob. Each table is kept sorted by score,
+// highest first; an empty slot has score 0, which never qualifies.
+#define MG_BOARD_SIZE    5
+#define MG_BOARD_VERSION 1
+#define MG_INITIALS      3
+
+struct MgScoreEntry {
+  char initials[MG_INITIALS];
+  uint8_t reserved;
+  uint16_t score;
+  uint16_t seconds;
+  uint32_t seed;
+};
+
+struct MgLeaderboard {
+  uint8_t version;
+  char lastInitials[MG_INITIALS];
+  MgScoreEntry entries[MINIGAME_COUNT][MG_BOARD_SIZE];
+};
+
+void mgBoardReset(MgLeaderboard& board);
+// Checks a board read back from storage, blobBytes long.
+bool mgBoardValid(const MgLeaderboard& board, size_t blobBytes);
+// Rank (0 = best) a score would take, or -1 if it does not make the table.
+// Ties rank below the scores already there.
+int8_t mgBoardRank(const MgLeaderboard& board, uint8_t game, uint16_t score);
+// Shifts the lower entries down one slot in place and writes entry at its
+// rank. Returns the rank, or -1 if it did not qualify.
+int8_t mgBoardInsert(MgLeaderboard& board, uint8_t game, const MgScoreEntry& entry);
+
+#endif
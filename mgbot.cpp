@@ -0,0 +1,266 @@
+#include "mgbot.h"
+#include "minigames.h"
+#include <math.h>
+#include <string.h>
+
+#define BOT_SD_LANE_STEP     6
+#define BOT_SD_LANES         ((SCREEN_W - SD_PLAYER_W) / BOT_SD_LANE_STEP + 1)
+#define BOT_SD_HORIZON       1.5f
+#define BOT_SD_SIM_DT        (1.0f / 30)
+#define BOT_SD_REPLAN_TICKS  (MG_TICK_HZ / 20)
+#define BOT_AB_KITE_DIST  24.0f
+#define BOT_AB_WALL       16.0f
+
+// Full deflection towards (dx, dy).
+static JoystickState botStick(int8_t dx, int8_t dy, bool button) {
+  JoystickState js = {};
+  js.ax = (int8_t)(dx * JOYSTICK_AXIS_STEPS);
+  js.ay = (int8_t)(dy * JOYSTICK_AXIS_STEPS);
+  js.button = button;
+  js.connected = true;
+  return js;
+}
+
+static int8_t botSign(float v, float deadband) {
+  if (v > deadband) return 1;
+  if (v < -deadband) return -1;
+  return 0;
+}
+
+// Stays inside the gap of the obstacle being passed while lining up with
+// the nearest reachable point of the next gap, and goes for a mana orb
+// only when no obstacle is close.
+static JoystickState botManaRunner() {
+  const float px = 30;
+  const MRObstacles& o = mrState.obstacles;
+  float py = mrState.playerY;
+  int16_t first = -1, second = -1;
+
+  for (uint16_t k = 0; k < o.pool.count; k++) {
+    uint16_t id = o.pool.dense[k];
+    if (o.x[id] + 12 < px) continue;
+    if (first < 0 || o.x[id] < o.x[first]) {
+      second = first;
+      first = id;
+    } else if (second < 0 || o.x[id] < o.x[second]) {
+      second = id;
+    }
+  }
+
+  float target = MR_PLAY_Y + MR_PLAY_H / 2 - MR_PLAYER_SIZE / 2;
+  if (first < 0 || o.x[first] > px + 80) {
+    const MRMana& m = mrState.mana;
+    float best = (first < 0) ? SCREEN_W * 2 : o.x[first];
+    for (uint16_t k = 0; k < m.pool.count; k++) {
+      uint16_t id = m.pool.dense[k];
+      if (m.x[id] < px || m.x[id] > best) continue;
+      best = m.x[id];
+      target = m.y[id] - MR_PLAYER_SIZE / 2;
+    }
+  }
+  if (first >= 0) {
+    float lo = o.gapY[first] - o.gapSize[first] / 2 + 2;
+    float hi = o.gapY[first] + o.gapSize[first] / 2 - MR_PLAYER_SIZE - 2;
+    target = (py < lo) ? lo : (py > hi) ? hi : py;
+    if (second >= 0 && px + MR_PLAYER_SIZE > o.x[first] - 4) {
+      float lo2 = o.gapY[second] - o.gapSize[second] / 2 + 2;
+      float hi2 = o.gapY[second] + o.gapSize[second] / 2 - MR_PLAYER_SIZE - 2;
+      target = (py < lo2) ? lo2 : (py > hi2) ? hi2 : py;
+      if (target < lo) target = lo;
+      if (target > hi) target = hi;
+    }
+  }
+  return botStick(0, botSign(target - py, 0.5f), false);
+}
+
+// Closes in on the nearest enemy and attacks whenever one is in reach,
+// backing off while the attack is still running. Walls push the player
+// back towards the middle so it is not pinned in a corner.
+static JoystickState botArena() {
+  const ABEnemies& e = abState.enemies;
+  float px = abState.playerX;
+  float py = abState.playerY;
+  float nearD2 = 1e9f;
+  float nx = 0, ny = 0;
+
+  for (uint16_t k = 0; k < e.pool.count; k++) {
+    uint16_t id = e.pool.dense[k];
+    float dx = e.x[id] - px;
+    float dy = e.y[id] - py;
+    float d2 = dx * dx + dy * dy;
+    if (d2 < nearD2) {
+      nearD2 = d2;
+      nx = dx;
+      ny = dy;
+    }
+  }
+
+  float reach = AB_ATTACK_RADIUS - 2;
+  bool attack = !abState.attacking && nearD2 < reach * reach;
+  float vx = 0, vy = 0;
+  if (e.pool.count > 0) {
+    float inv = 1.0f / sqrtf(nearD2 + 0.01f);
+    float toward = (abState.attacking && nearD2 < BOT_AB_KITE_DIST * BOT_AB_KITE_DIST) ? -1.0f : 1.0f;
+    vx = nx * inv * toward;
+    vy = ny * inv * toward;
+  }
+
+  if (px < BOT_AB_WALL) vx += 1;
+  if (px > SCREEN_W - 10 - BOT_AB_WALL) vx -= 1;
+  if (py < AB_PLAY_Y + BOT_AB_WALL) vy += 1;
+  if (py > AB_PLAY_Y + AB_PLAY_H - 10 - BOT_AB_WALL) vy -= 1;
+  return botStick(botSign(vx, 0.38f), botSign(vy, 0.38f), attack);
+}
+
+static uint16_t botQueue[SNAKE_CELLS];
+static uint16_t botParent[SNAKE_CELLS];
+static uint32_t botSeen[SNAKE_WORDS];
+static uint16_t botSnakeHead = 0xFFFF;
+static uint16_t botSnakeFood = 0xFFFF;
+static uint16_t botSnakeLen = 0;
+static uint16_t botSnakeStep;
+
+static uint16_t botNeighbour(uint16_t cell, uint8_t dir) {
+  uint8_t x = cell % SNAKE_COLS;
+  uint8_t y = cell / SNAKE_COLS;
+  switch (dir) {
+    case 0:  x = (x + 1) % SNAKE_COLS; break;
+    case 1:  x = (x + SNAKE_COLS - 1) % SNAKE_COLS; break;
+    case 2:  y = (y + 1) % SNAKE_ROWS; break;
+    default: y = (y + SNAKE_ROWS - 1) % SNAKE_ROWS; break;
+  }
+  return y * SNAKE_COLS + x;
+}
+
+static inline void botMark(uint16_t cell) {
+  botSeen[cell >> 5] |= 1UL << (cell & 31);
+}
+
+// Breadth-first search over the free cells from start. The tail counts as
+// free since it moves away on the next step. Returns the number of cells
+// reached; stops early and sets found when goal is reached.
+static uint16_t botFlood(uint16_t start, uint16_t goal, bool& found) {
+  memcpy(botSeen, snState.occupied, sizeof(botSeen));
+  uint16_t tail = snakeSegment(snState, snState.length - 1);
+  botSeen[tail >> 5] &= ~(1UL << (tail & 31));
+  botMark(start);
+
+  uint16_t head = 0, size = 0;
+  botQueue[size++] = start;
+  found = false;
+  while (head < size) {
+    uint16_t cell = botQueue[head++];
+    for (uint8_t d = 0; d < 4; d++) {
+      uint16_t n = botNeighbour(cell, d);
+      if (snakeCellSet(botSeen, n)) continue;
+      botMark(n);
+      botParent[n] = cell;
+      botQueue[size++] = n;
+      if (n == goal) {
+        found = true;
+        return size;
+      }
+    }
+  }
+  return size;
+}
+
+// Follows the shortest path to the food. With no path it moves to the
+// neighbour with the most room left and waits for the body to clear.
+static uint16_t botSnakePlan() {
+  uint16_t start = snakeSegment(snState, 0);
+  uint16_t food = snState.foodY * SNAKE_COLS + snState.foodX;
+  bool found;
+  botFlood(start, food, found);
+  if (found) {
+    uint16_t cell = food;
+    while (botParent[cell] != start) cell = botParent[cell];
+    return cell;
+  }
+
+  uint16_t best = botNeighbour(start, 0);
+  uint16_t bestRoom = 0;
+  for (uint8_t d = 0; d < 4; d++) {
+    uint16_t n = botNeighbour(start, d);
+    bool blocked = snakeCellSet(snState.occupied, n) && n != snakeSegment(snState, snState.length - 1);
+    if (blocked) continue;
+    uint16_t room = botFlood(n, SNAKE_CELLS, found);
+    if (room > bestRoom) {
+      bestRoom = room;
+      best = n;
+    }
+  }
+  return best;
+}
+
+static JoystickState botSnake() {
+  uint16_t head = snakeSegment(snState, 0);
+  uint16_t food = snState.foodY * SNAKE_COLS + snState.foodX;
+  if (head != botSnakeHead || food != botSnakeFood || snState.length != botSnakeLen) {
+    botSnakeStep = botSnakePlan();
+    botSnakeHead = head;
+    botSnakeFood = food;
+    botSnakeLen = snState.length;
+  }
+
+  int dx = (int)(botSnakeStep % SNAKE_COLS) - (int)(head % SNAKE_COLS);
+  int dy = (int)(botSnakeStep / SNAKE_COLS) - (int)(head / SNAKE_COLS);
+  if (dx > 1) dx = -1;
+  if (dx < -1) dx = 1;
+  if (dy > 1) dy = -1;
+  if (dy < -1) dy = 1;
+  return botStick((int8_t)dx, (int8_t)dy, false);
+}
+
+static uint8_t botDodgeTarget;
+static uint8_t botDodgeAge;
+
+// Seconds until the player, walking to lane and then waiting there, is
+// hit by a spell already on screen, or BOT_SD_HORIZON if it never is.
+static float botDodgeSurvival(uint8_t lane) {
+  const SDSpells& sp = sdState.spells;
+  const float py = SCREEN_H - 20;
+  float goal = lane * BOT_SD_LANE_STEP;
+  float x = sdState.playerX;
+  for (float t = 0; t < BOT_SD_HORIZON; t += BOT_SD_SIM_DT) {
+    float fall = sdState.spellSpeed * t;
+    for (uint16_t k = 0; k < sp.pool.count; k++) {
+      uint16_t id = sp.pool.dense[k];
+      float sy = sp.y[id] + fall;
+      if (sp.x[id] + 9 > x && sp.x[id] < x + SD_PLAYER_W + 1 && sy + 8 > py && sy < py + SD_PLAYER_H) return t;
+    }
+    float step = SD_PLAYER_SPEED * BOT_SD_SIM_DT;
+    if (x < goal) x = (goal - x < step) ? goal : x + step;
+    else if (x > goal) x = (x - goal < step) ? goal : x - step;
+  }
+  return BOT_SD_HORIZON;
+}
+
+// Plays each lane forward against the falling spells a few times a
+// second and heads for the one that keeps the player alive longest,
+// preferring nearer lanes on a tie.
+static JoystickState botSpellDodge() {
+  if (botDodgeAge-- == 0) {
+    botDodgeAge = BOT_SD_REPLAN_TICKS - 1;
+    float here = sdState.playerX / BOT_SD_LANE_STEP;
+    float bestScore = -1;
+    for (uint8_t l = 0; l < BOT_SD_LANES; l++) {
+      float score = botDodgeSurvival(l) - fabsf(l - here) * 0.001f;
+      if (score > bestScore) {
+        bestScore = score;
+        botDodgeTarget = l;
+      }
+    }
+  }
+  return botStick(botSign(botDodgeTarget * BOT_SD_LANE_STEP - sdState.playerX, 0.5f), 0, false);
+}
+
+JoystickState mgBotInput(uint8_t game) {
+  switch (game) {
+    case 0:  return botManaRunner();
+    case 1:  return botArena();
+    case 2:  return botSnake();
+    case 3:  return botSpellDodge();
+    default: return botStick(0, 0, false);
+  }
+}
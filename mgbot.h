@@ -0,0 +1,15 @@
+#ifndef MGBOT_H
+#define MGBOT_H
+
+#include <stdint.h>
+#include "joystick.h"
+
+// Autoplay controllers used by the soak mode and the host runner. Each
+// one reads its game's global state and returns the stick input for the
+// next tick, so it must be called between ticks of a live game. Like the
+// game logic this has no device dependencies.
+//
+// game is the MINIGAMES index.
+JoystickState mgBotInput(uint8_t game);
+
+#endif
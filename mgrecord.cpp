@@ -0,0 +1,98 @@
+#include "mgrecord.h"
+#include <string.h>
+
+#define REC_AXIS_LEVELS (2 * JOYSTICK_AXIS_STEPS + 1)
+
+static_assert(REC_AXIS_LEVELS * REC_AXIS_LEVELS * 2 <= 256, "a sample must fit in one byte");
+
+uint8_t mgInputSample(const JoystickState& js) {
+  return (uint8_t)((js.ax + JOYSTICK_AXIS_STEPS) + REC_AXIS_LEVELS * (js.ay + JOYSTICK_AXIS_STEPS) +
+                   REC_AXIS_LEVELS * REC_AXIS_LEVELS * (js.button ? 1 : 0));
+}
+
+JoystickState mgInputFromSample(uint8_t sample) {
+  JoystickState js = {};
+  js.ax = (int8_t)(sample % REC_AXIS_LEVELS) - JOYSTICK_AXIS_STEPS;
+  js.ay = (int8_t)((sample / REC_AXIS_LEVELS) % REC_AXIS_LEVELS) - JOYSTICK_AXIS_STEPS;
+  js.button = sample >= REC_AXIS_LEVELS * REC_AXIS_LEVELS;
+  js.connected = true;
+  return js;
+}
+
+static bool putByte(MgRecorder& r, uint8_t b) {
+  if (r.rec->length >= MG_REC_BYTES) {
+    r.overflow = true;
+    return false;
+  }
+  r.rec->data[r.rec->length++] = b;
+  return true;
+}
+
+static void flushRun(MgRecorder& r) {
+  if (r.run == 0) return;
+  putByte(r, r.sample);
+  uint32_t rest = r.run - 1;
+  do {
+    uint8_t b = rest & 0x7F;
+    rest >>= 7;
+    if (!putByte(r, b | (rest ? 0x80 : 0))) break;
+  } while (rest);
+  r.run = 0;
+}
+
+void mgRecBegin(MgRecorder& r, MgRecording& rec, uint8_t game, uint32_t seed) {
+  memset(&rec, 0, MG_REC_HEADER_BYTES);
+  rec.version = MG_REC_VERSION;
+  rec.game = game;
+  rec.seed = seed;
+  r.rec = &rec;
+  r.sample = 0;
+  r.run = 0;
+  r.overflow = false;
+}
+
+void mgRecPush(MgRecorder& r, const JoystickState& js) {
+  if (r.overflow) return;
+  uint8_t sample = mgInputSample(js);
+  if (r.run > 0 && sample != r.sample) flushRun(r);
+  r.sample = sample;
+  r.run++;
+  r.rec->ticks++;
+}
+
+bool mgRecEnd(MgRecorder& r, uint16_t score) {
+  flushRun(r);
+  r.rec->score = score;
+  return !r.overflow;
+}
+
+bool mgRecValid(const MgRecording& rec, size_t blobBytes) {
+  return blobBytes >= MG_REC_HEADER_BYTES && rec.version == MG_REC_VERSION &&
+         rec.length <= MG_REC_BYTES && blobBytes == MG_REC_HEADER_BYTES + rec.length;
+}
+
+void mgPlayBegin(MgPlayer& p, const MgRecording& rec) {
+  p.rec = &rec;
+  p.pos = 0;
+  p.sample = 0;
+  p.left = 0;
+}
+
+bool mgPlayNext(MgPlayer& p, JoystickState& js) {
+  if (p.left == 0) {
+    if (p.pos >= p.rec->length) return false;
+    p.sample = p.rec->data[p.pos++];
+    uint32_t rest = 0;
+    uint8_t shift = 0;
+    while (p.pos < p.rec->length && shift < 32) {
+      uint8_t v = p.rec->data[p.pos++];
+      rest |= (uint32_t)(v & 0x7F) << shift;
+      shift += 7;
+      if (!(v & 0x80)) break;
+    }
+    p.left = rest + 1;
+  }
+  p.left--;
+  js = mgInputFromSample(p.sample);
+  return true;
+}
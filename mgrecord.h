@@ -0,0 +1,59 @@
+#ifndef MGRECORD_H
+#define MGRECORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "joystick.h"
+
+// A minigame run is its PRNG seed plus one input sample per logic tick;
+// replaying the samples from the same seed reproduces the run exactly.
+//
+// Games read the quantized stick axes and the button, so a sample is
+// one byte: (ax + 4) + 9 * (ay + 4) + 81 * button. Each sample in data[]
+// is followed by a LEB128 count of (ticks - 1) it was held for. Kept free
+// of Arduino headers so host tools can read and write recordings.
+#define MG_REC_BYTES   4096
+#define MG_REC_VERSION 2
+
+struct MgRecording {
+  uint8_t version;
+  uint8_t game;
+  uint16_t score;
+  uint32_t seed;
+  uint32_t ticks;
+  uint16_t length;
+  uint8_t data[MG_REC_BYTES];
+};
+
+#define MG_REC_HEADER_BYTES offsetof(MgRecording, data)
+
+struct MgRecorder {
+  MgRecording* rec;
+  uint8_t sample;
+  uint32_t run;
+  bool overflow;
+};
+
+struct MgPlayer {
+  const MgRecording* rec;
+  uint16_t pos;
+  uint8_t sample;
+  uint32_t left;
+};
+
+uint8_t mgInputSample(const JoystickState& js);
+JoystickState mgInputFromSample(uint8_t sample);
+
+void mgRecBegin(MgRecorder& r, MgRecording& rec, uint8_t game, uint32_t seed);
+void mgRecPush(MgRecorder& r, const JoystickState& js);
+// Flushes the last run and stores the score. Returns false if the run
+// did not fit in MG_REC_BYTES.
+bool mgRecEnd(MgRecorder& r, uint16_t score);
+
+// Checks a recording read back from storage, blobBytes long.
+bool mgRecValid(const MgRecording& rec, size_t blobBytes);
+void mgPlayBegin(MgPlayer& p, const MgRecording& rec);
+// Returns false once every recorded tick has been played.
+bool mgPlayNext(MgPlayer& p, JoystickState& js);
+
+#endif
@@ -1,223 +1,203 @@
 #include "minigames.h"
-#include "display.h"
-#include "audio.h"
+#include "spatial_grid.h"
+#include <math.h>
+#include <string.h>
 
-static const uint16_t MANA_COLORS[] = {MTG_WHITE, MTG_BLUE, MTG_RED, MTG_GREEN, 0xC8DF};
-static const uint8_t MANA_COLOR_COUNT = 5;
+// Game logic only: no display, speaker or clock access, so this file also
+// builds for the host runner in bench/. Rendering and the device frame
+// loop live in minigames_render.cpp.
 
-#define AB_ATTACK_RADIUS  20
-#define GRID_DOT_COLOR    0x1082
+static inline int32_t mgRandom(MgContext& ctx, uint32_t bound) {
+  return (int32_t)prngStateBelow(ctx.rng, bound);
+}
+
+static inline void mgSound(const MgContext& ctx, MgSound sfx) {
+  if (ctx.sound) ctx.sound(sfx);
+}
+
+// Quake-style reciprocal square root with one Newton step (~0.2% error),
+// much cheaper than sqrtf plus a divide on the ESP32 FPU.
+static inline float fastInvSqrt(float x) {
+  uint32_t i;
+  float y;
+  memcpy(&i, &x, sizeof(i));
+  i = 0x5F3759DF - (i >> 1);
+  memcpy(&y, &i, sizeof(y));
+  return y * (1.5f - 0.5f * x * y * y);
+}
+
+ManaRunnerState mrState;
+ArenaBattleState abState;
+SnakeState snState;
+SpellDodgeState sdState;
 
-static ManaRunnerState mrState;
-static ArenaBattleState abState;
-static SnakeState snState;
-static SpellDodgeState sdState;
+static SpatialGrid<MG_GRID_MAX_ITEMS, SCREEN_W, SCREEN_H, MG_GRID_CELL_SHIFT> mgGrid;
 
-static void manaRunnerInit() {
+static void manaRunnerInit(MgContext&) {
   memset(&mrState, 0, sizeof(mrState));
+  mrState.obstacles.pool.clear();
+  mrState.mana.pool.clear();
   mrState.playerY = MR_PLAY_Y + MR_PLAY_H / 2;
-  mrState.speed = 2.0f;
+  mrState.prevPlayerY = mrState.playerY;
+  mrState.speed = MR_BASE_SPEED;
   mrState.alive = true;
-  mrState.startMs = millis();
-  mrState.lastSpawnMs = millis();
 }
 
-static void manaRunnerSpawnObstacle() {
-  for (int i = 0; i < MR_MAX_OBSTACLES; i++) {
-    if (!mrState.obstacles[i].active) {
-      mrState.obstacles[i].active = true;
-      mrState.obstacles[i].x = SCREEN_W + 10;
-      mrState.obstacles[i].gapY = MR_PLAY_Y + 25 + random(MR_PLAY_H - 50);
-      mrState.obstacles[i].gapSize = 40 - min((int)(mrState.speed), 8);
-      if (mrState.obstacles[i].gapSize < 28) mrState.obstacles[i].gapSize = 28;
-      return;
-    }
-  }
+static void manaRunnerSpawnObstacle(MgContext& ctx) {
+  MRObstacles& o = mrState.obstacles;
+  int16_t id = o.pool.spawn();
+  if (id < 0) return;
+  o.x[id] = SCREEN_W + 10;
+  o.prevX[id] = o.x[id];
+  o.gapY[id] = MR_PLAY_Y + 25 + mgRandom(ctx, MR_PLAY_H - 50);
+  int shrink = (int)(mrState.speed / 20);
+  o.gapSize[id] = 40 - (shrink < 8 ? shrink : 8);
+  if (o.gapSize[id] < 28) o.gapSize[id] = 28;
 }
 
-static void manaRunnerSpawnMana() {
-  for (int i = 0; i < MR_MAX_MANA; i++) {
-    if (!mrState.mana[i].active) {
-      mrState.mana[i].active = true;
-      mrState.mana[i].x = SCREEN_W + 10;
-      mrState.mana[i].y = MR_PLAY_Y + 10 + random(MR_PLAY_H - 20);
-      mrState.mana[i].colorIdx = random(MANA_COLOR_COUNT);
-      return;
-    }
-  }
+static void manaRunnerSpawnMana(MgContext& ctx) {
+  MRMana& m = mrState.mana;
+  int16_t id = m.pool.spawn();
+  if (id < 0) return;
+  m.x[id] = SCREEN_W + 10;
+  m.prevX[id] = m.x[id];
+  m.y[id] = MR_PLAY_Y + 10 + mgRandom(ctx, MR_PLAY_H - 20);
+  m.colorIdx[id] = mgRandom(ctx, MANA_COLOR_COUNT);
 }
 
-static void manaRunnerUpdate(const JoystickState& js) {
+static void manaRunnerUpdate(MgContext& ctx, const JoystickState& js) {
   if (!mrState.alive) return;
+  unsigned long now = ctx.nowMs;
 
-  int8_t dy = joystickDirY(js);
-  mrState.playerY += dy * 3.0f;
+  mrState.prevPlayerY = mrState.playerY;
+  MRObstacles& o = mrState.obstacles;
+  MRMana& m = mrState.mana;
+
+  mrState.playerY += joystickAxisY(js) * MR_PLAYER_SPEED * MG_DT;
   if (mrState.playerY < MR_PLAY_Y + 4) mrState.playerY = MR_PLAY_Y + 4;
   if (mrState.playerY > MR_PLAY_Y + MR_PLAY_H - MR_PLAYER_SIZE - 4)
     mrState.playerY = MR_PLAY_Y + MR_PLAY_H - MR_PLAYER_SIZE - 4;
 
 
-  unsigned long elapsed = millis() - mrState.startMs;
-  mrState.speed = 2.0f + elapsed / 5000.0f;
-  if (mrState.speed > 6.0f) mrState.speed = 6.0f;
+  unsigned long elapsed = now - mrState.startMs;
+  mrState.speed = MR_BASE_SPEED + elapsed / 250.0f;
+  if (mrState.speed > MR_MAX_SPEED) mrState.speed = MR_MAX_SPEED;
 
 
-  if (millis() - mrState.lastSpawnMs > (unsigned long)(1200 / mrState.speed * 2)) {
-    manaRunnerSpawnObstacle();
-    if (random(3) == 0) manaRunnerSpawnMana();
-    mrState.lastSpawnMs = millis();
+  if (now - mrState.lastSpawnMs > (unsigned long)(48000 / mrState.speed)) {
+    manaRunnerSpawnObstacle(ctx);
+    if (mgRandom(ctx, 3) == 0) manaRunnerSpawnMana(ctx);
+    mrState.lastSpawnMs = now;
   }
 
   float px = 30;
   float py = mrState.playerY;
 
 
-  for (int i = 0; i < MR_MAX_OBSTACLES; i++) {
-    if (!mrState.obstacles[i].active) continue;
-    mrState.obstacles[i].x -= mrState.speed;
-    if (mrState.obstacles[i].x < -20) {
-      mrState.obstacles[i].active = false;
+  for (uint16_t k = o.pool.count; k-- > 0;) {
+    uint16_t id = o.pool.dense[k];
+    o.prevX[id] = o.x[id];
+    o.x[id] -= mrState.speed * MG_DT;
+    if (o.x[id] < -20) {
+      o.pool.kill(id);
       mrState.score++;
       continue;
     }
 
 
-    float ox = mrState.obstacles[i].x;
-    float gapTop = mrState.obstacles[i].gapY - mrState.obstacles[i].gapSize / 2;
-    float gapBot = mrState.obstacles[i].gapY + mrState.obstacles[i].gapSize / 2;
+    float ox = o.x[id];
+    float gapTop = o.gapY[id] - o.gapSize[id] / 2;
+    float gapBot = o.gapY[id] + o.gapSize[id] / 2;
 
     if (px + MR_PLAYER_SIZE > ox && px < ox + 12) {
       if (py < gapTop || py + MR_PLAYER_SIZE > gapBot) {
         mrState.alive = false;
-        audioGameOver();
+        mgSound(ctx, MG_SFX_GAME_OVER);
         return;
       }
     }
   }
 
 
-  for (int i = 0; i < MR_MAX_MANA; i++) {
-    if (!mrState.mana[i].active) continue;
-    mrState.mana[i].x -= mrState.speed * 0.8f;
-    if (mrState.mana[i].x < -10) {
-      mrState.mana[i].active = false;
+  for (uint16_t k = m.pool.count; k-- > 0;) {
+    uint16_t id = m.pool.dense[k];
+    m.prevX[id] = m.x[id];
+    m.x[id] -= mrState.speed * 0.8f * MG_DT;
+    if (m.x[id] < -10) {
+      m.pool.kill(id);
       continue;
     }
 
 
-    float mx = mrState.mana[i].x;
-    float my = mrState.mana[i].y;
-    if (abs(px + 4 - mx) < 10 && abs(py + 4 - my) < 10) {
-      mrState.mana[i].active = false;
+    if (fabsf(px + 4 - m.x[id]) < 10 && fabsf(py + 4 - m.y[id]) < 10) {
+      m.pool.kill(id);
       mrState.score += 5;
-      audioGamePoint();
+      mgSound(ctx, MG_SFX_POINT);
     }
   }
 }
 
-static void manaRunnerRender() {
-  M5Canvas& spr = displayGetSprite();
-  displayBeginDraw();
-
-
-  spr.setTextSize(1);
-  spr.setTextColor(COLOR_TEXT, COLOR_BG);
-  spr.setCursor(5, 3);
-  spr.print("Mana Runner");
-  char buf[16];
-  snprintf(buf, sizeof(buf), "Score: %d", mrState.score);
-  spr.setCursor(160, 3);
-  spr.print(buf);
 
-
-  spr.drawFastHLine(0, MR_PLAY_Y - 1, SCREEN_W, COLOR_DIVIDER);
-
-  if (!mrState.alive) {
-    displayMiniGameOver(mrState.score);
-    return;
-  }
-
-
-  for (int i = 0; i < MR_MAX_OBSTACLES; i++) {
-    if (!mrState.obstacles[i].active) continue;
-    int ox = (int)mrState.obstacles[i].x;
-    int gapTop = mrState.obstacles[i].gapY - mrState.obstacles[i].gapSize / 2;
-    int gapBot = mrState.obstacles[i].gapY + mrState.obstacles[i].gapSize / 2;
-
-
-    if (gapTop > MR_PLAY_Y)
-      spr.fillRect(ox, MR_PLAY_Y, 12, gapTop - MR_PLAY_Y, MTG_RED);
-
-    if (gapBot < MR_PLAY_Y + MR_PLAY_H)
-      spr.fillRect(ox, gapBot, 12, MR_PLAY_Y + MR_PLAY_H - gapBot, MTG_RED);
-  }
-
-
-  for (int i = 0; i < MR_MAX_MANA; i++) {
-    if (!mrState.mana[i].active) continue;
-    spr.fillCircle((int)mrState.mana[i].x, (int)mrState.mana[i].y, 4,
-                   MANA_COLORS[mrState.mana[i].colorIdx]);
-  }
-
-  spr.fillRect(30, (int)mrState.playerY, MR_PLAYER_SIZE, MR_PLAYER_SIZE, MTG_WHITE);
-  spr.drawRect(30, (int)mrState.playerY, MR_PLAYER_SIZE, MR_PLAYER_SIZE, MTG_BLUE);
-
-  displayEndDraw();
+static void arenaSpawnEnemy(MgContext& ctx) {
+  ABEnemies& e = abState.enemies;
+  int16_t id = e.pool.spawn();
+  if (id < 0) return;
+  e.colorIdx[id] = mgRandom(ctx, MANA_COLOR_COUNT);
+
+
+  uint8_t edge = mgRandom(ctx, 4);
+  switch (edge) {
+    case 0:
+      e.x[id] = mgRandom(ctx, SCREEN_W);
+      e.y[id] = AB_PLAY_Y;
+      break;
+    case 1:
+      e.x[id] = mgRandom(ctx, SCREEN_W);
+      e.y[id] = AB_PLAY_Y + AB_PLAY_H - 6;
+      break;
+    case 2:
+      e.x[id] = 0;
+      e.y[id] = AB_PLAY_Y + mgRandom(ctx, AB_PLAY_H);
+      break;
+    case 3:
+      e.x[id] = SCREEN_W - 6;
+      e.y[id] = AB_PLAY_Y + mgRandom(ctx, AB_PLAY_H);
+      break;
+  }
+  e.prevX[id] = e.x[id];
+  e.prevY[id] = e.y[id];
 }
 
-static void arenaSpawnEnemy() {
-  for (int i = 0; i < AB_MAX_ENEMIES; i++) {
-    if (!abState.enemies[i].alive) {
-      abState.enemies[i].alive = true;
-      abState.enemies[i].colorIdx = random(MANA_COLOR_COUNT);
-
-
-      uint8_t edge = random(4);
-      switch (edge) {
-        case 0:
-          abState.enemies[i].x = random(SCREEN_W);
-          abState.enemies[i].y = AB_PLAY_Y;
-          break;
-        case 1:
-          abState.enemies[i].x = random(SCREEN_W);
-          abState.enemies[i].y = AB_PLAY_Y + AB_PLAY_H - 6;
-          break;
-        case 2:
-          abState.enemies[i].x = 0;
-          abState.enemies[i].y = AB_PLAY_Y + random(AB_PLAY_H);
-          break;
-        case 3:
-          abState.enemies[i].x = SCREEN_W - 6;
-          abState.enemies[i].y = AB_PLAY_Y + random(AB_PLAY_H);
-          break;
-      }
-      return;
-    }
-  }
+static void arenaFill(MgContext& ctx) {
+  while (abState.enemies.pool.count < AB_MAX_ENEMIES) arenaSpawnEnemy(ctx);
 }
 
-static void arenaInit() {
+static void arenaInit(MgContext& ctx) {
   memset(&abState, 0, sizeof(abState));
+  abState.enemies.pool.clear();
   abState.playerX = SCREEN_W / 2;
   abState.playerY = AB_PLAY_Y + AB_PLAY_H / 2;
+  abState.prevPlayerX = abState.playerX;
+  abState.prevPlayerY = abState.playerY;
   abState.hp = 3;
   abState.wave = 1;
   abState.alive = true;
-  abState.lastSpawnMs = millis();
   abState.lastHitMs = 0;
 
 
-  for (int i = 0; i < 3; i++) arenaSpawnEnemy();
+  for (int i = 0; i < 3; i++) arenaSpawnEnemy(ctx);
 }
 
-static void arenaUpdate(const JoystickState& js) {
+static void arenaUpdate(MgContext& ctx, const JoystickState& js) {
   if (!abState.alive) return;
+  unsigned long now = ctx.nowMs;
 
+  abState.prevPlayerX = abState.playerX;
+  abState.prevPlayerY = abState.playerY;
+  ABEnemies& e = abState.enemies;
 
-  int8_t dx = joystickDirX(js);
-  int8_t dy = joystickDirY(js);
-  abState.playerX += dx * 3.0f;
-  abState.playerY += dy * 3.0f;
+  abState.playerX += joystickAxisX(js) * AB_PLAYER_SPEED * MG_DT;
+  abState.playerY += joystickAxisY(js) * AB_PLAYER_SPEED * MG_DT;
 
 
   if (abState.playerX < 4) abState.playerX = 4;
@@ -226,55 +206,92 @@ static void arenaUpdate(const JoystickState& js) {
   if (abState.playerY > AB_PLAY_Y + AB_PLAY_H - 10) abState.playerY = AB_PLAY_Y + AB_PLAY_H - 10;
 
 
-  if (js.button && !abState.attacking) {
-    abState.attacking = true;
-    abState.attackStartMs = millis();
-    audioGameAttack();
-
-
-    for (int i = 0; i < AB_MAX_ENEMIES; i++) {
-      if (!abState.enemies[i].alive) continue;
-      float edx = abState.enemies[i].x - abState.playerX;
-      float edy = abState.enemies[i].y - abState.playerY;
-      if (edx * edx + edy * edy < AB_ATTACK_RADIUS * AB_ATTACK_RADIUS) {
-        abState.enemies[i].alive = false;
-        abState.score += 10;
-        audioGamePoint();
-      }
-    }
-  }
-
-
-  if (abState.attacking && millis() - abState.attackStartMs > 200) {
+  if (abState.attacking && now - abState.attackStartMs > 200) {
     abState.attacking = false;
   }
 
 
-  float enemySpeed = 0.8f + abState.wave * 0.2f;
-  if (enemySpeed > 3.0f) enemySpeed = 3.0f;
-
-  bool invincible = (millis() - abState.lastHitMs < 1000);
+  float enemySpeed = AB_ENEMY_BASE_SPEED + abState.wave * AB_ENEMY_WAVE_SPEED;
+  if (enemySpeed > AB_ENEMY_MAX_SPEED) enemySpeed = AB_ENEMY_MAX_SPEED;
+  float enemyStep = enemySpeed * MG_DT;
 
-  for (int i = 0; i < AB_MAX_ENEMIES; i++) {
-    if (!abState.enemies[i].alive) continue;
-
-    float edx = abState.playerX - abState.enemies[i].x;
-    float edy = abState.playerY - abState.enemies[i].y;
-    float dist = sqrt(edx * edx + edy * edy);
-    if (dist > 1) {
-      abState.enemies[i].x += (edx / dist) * enemySpeed;
-      abState.enemies[i].y += (edy / dist) * enemySpeed;
+  mgGrid.begin();
+  for (uint16_t k = 0; k < e.pool.count; k++) {
+    uint16_t id = e.pool.dense[k];
+    e.prevX[id] = e.x[id];
+    e.prevY[id] = e.y[id];
+    float edx = abState.playerX - e.x[id];
+    float edy = abState.playerY - e.y[id];
+    float d2 = edx * edx + edy * edy;
+    if (d2 > 1) {
+      float inv = fastInvSqrt(d2) * enemyStep;
+      e.x[id] += edx * inv;
+      e.y[id] += edy * inv;
     }
+    mgGrid.add(id, e.x[id], e.y[id]);
+  }
+  mgGrid.build();
 
-
-    if (!invincible && dist < 8) {
+  if (js.button && !abState.attacking) {
+    abState.attacking = true;
+    abState.attackStartMs = now;
+    mgSound(ctx, MG_SFX_ATTACK);
+
+    bool killed = false;
+    mgGrid.query(abState.playerX - AB_ATTACK_RADIUS, abState.playerY - AB_ATTACK_RADIUS,
+                 abState.playerX + AB_ATTACK_RADIUS, abState.playerY + AB_ATTACK_RADIUS,
+                 [&](uint16_t id) {
+      float edx = e.x[id] - abState.playerX;
+      float edy = e.y[id] - abState.playerY;
+      if (e.pool.alive(id) && edx * edx + edy * edy < AB_ATTACK_RADIUS * AB_ATTACK_RADIUS) {
+        e.pool.kill(id);
+        abState.score += 10;
+        killed = true;
+      }
+    });
+    if (killed) mgSound(ctx, MG_SFX_POINT);
+  }
+
+  // Neighbours closer than AB_ENEMY_SPACING push each other apart so a
+  // large swarm spreads out instead of collapsing onto one point.
+  for (uint16_t k = 0; k < e.pool.count; k++) {
+    uint16_t a = e.pool.dense[k];
+    mgGrid.query(e.x[a] - AB_ENEMY_SPACING, e.y[a] - AB_ENEMY_SPACING,
+                 e.x[a] + AB_ENEMY_SPACING, e.y[a] + AB_ENEMY_SPACING, [&](uint16_t b) {
+      if (b <= a || !e.pool.alive(b)) return;
+      float sx = e.x[b] - e.x[a];
+      float sy = e.y[b] - e.y[a];
+      float d2 = sx * sx + sy * sy;
+      if (d2 >= AB_ENEMY_SPACING * AB_ENEMY_SPACING || d2 < 0.01f) return;
+      float push = (AB_ENEMY_SPACING * fastInvSqrt(d2) - 1.0f) * 0.25f;
+      e.x[a] -= sx * push;
+      e.y[a] -= sy * push;
+      e.x[b] += sx * push;
+      e.y[b] += sy * push;
+    });
+  }
+
+  bool invincible = (abState.lastHitMs > 0 && now - abState.lastHitMs < 1000);
+  if (!invincible) {
+    int hitId = -1;
+    // Separation may have nudged enemies since the grid was built, so the
+    // query box is widened by the push distance.
+    float r = 8 + AB_ENEMY_SPACING;
+    mgGrid.query(abState.playerX - r, abState.playerY - r, abState.playerX + r, abState.playerY + r,
+                 [&](uint16_t id) {
+      float edx = abState.playerX - e.x[id];
+      float edy = abState.playerY - e.y[id];
+      if (hitId < 0 && e.pool.alive(id) && edx * edx + edy * edy < 64) hitId = id;
+    });
+
+    if (hitId >= 0) {
       abState.hp--;
-      abState.lastHitMs = millis();
-      audioGameHit();
-      abState.enemies[i].alive = false;
+      abState.lastHitMs = now;
+      mgSound(ctx, MG_SFX_HIT);
+      e.pool.kill(hitId);
       if (abState.hp == 0) {
         abState.alive = false;
-        audioGameOver();
+        mgSound(ctx, MG_SFX_GAME_OVER);
         return;
       }
     }
@@ -283,9 +300,9 @@ static void arenaUpdate(const JoystickState& js) {
 
   unsigned long spawnBase = (abState.wave * 200 < 2000) ? (2000 - abState.wave * 200) : 0;
   unsigned long spawnInterval = (spawnBase > 800) ? spawnBase : 800;
-  if (millis() - abState.lastSpawnMs > spawnInterval) {
-    abState.lastSpawnMs = millis();
-    arenaSpawnEnemy();
+  if (now - abState.lastSpawnMs > spawnInterval) {
+    abState.lastSpawnMs = now;
+    arenaSpawnEnemy(ctx);
 
     uint8_t newWave = 1 + abState.score / 50;
     if (newWave > abState.wave) {
@@ -294,89 +311,62 @@ static void arenaUpdate(const JoystickState& js) {
   }
 }
 
-static void arenaRender() {
-  M5Canvas& spr = displayGetSprite();
-  displayBeginDraw();
-
-
-  spr.setTextSize(1);
-  spr.setTextColor(COLOR_TEXT, COLOR_BG);
-  spr.setCursor(5, 3);
-  char buf[24];
-  snprintf(buf, sizeof(buf), "HP:%d  Wave:%d", abState.hp, abState.wave);
-  spr.print(buf);
-  snprintf(buf, sizeof(buf), "Score: %d", abState.score);
-  spr.setCursor(160, 3);
-  spr.print(buf);
-
-  spr.drawFastHLine(0, AB_PLAY_Y - 1, SCREEN_W, COLOR_DIVIDER);
-
-  if (!abState.alive) {
-    displayMiniGameOver(abState.score);
-    return;
-  }
-
-
-  for (int i = 0; i < AB_MAX_ENEMIES; i++) {
-    if (!abState.enemies[i].alive) continue;
-    spr.fillRect((int)abState.enemies[i].x, (int)abState.enemies[i].y, 6, 6,
-                 MANA_COLORS[abState.enemies[i].colorIdx]);
-  }
-
 
-  if (abState.attacking) {
-    uint16_t attackColor = 0xFEA0;
-    spr.drawCircle((int)abState.playerX + 3, (int)abState.playerY + 3, 18, attackColor);
-    spr.drawCircle((int)abState.playerX + 3, (int)abState.playerY + 3, 20, attackColor);
-  }
+static inline bool snakeOccupied(uint16_t cell) {
+  return snakeCellSet(snState.occupied, cell);
+}
 
-  bool invincible = (millis() - abState.lastHitMs < 1000);
-  if (!invincible || (millis() / 100) % 2 == 0) {
-    spr.fillCircle((int)abState.playerX + 3, (int)abState.playerY + 3, 5, MTG_WHITE);
-    spr.drawCircle((int)abState.playerX + 3, (int)abState.playerY + 3, 5, MTG_BLUE);
+static inline void snakeSetOccupied(uint16_t cell, bool on) {
+  if (on) {
+    snState.occupied[cell >> 5] |= 1UL << (cell & 31);
+  } else {
+    snState.occupied[cell >> 5] &= ~(1UL << (cell & 31));
   }
-
-  displayEndDraw();
 }
 
-static void snakePlaceFood() {
-  bool valid;
-  do {
-    valid = true;
-    snState.foodX = random(SNAKE_COLS);
-    snState.foodY = random(SNAKE_ROWS);
-
-
-    for (int i = 0; i < snState.length; i++) {
-      if (snState.bodyX[i] == snState.foodX && snState.bodyY[i] == snState.foodY) {
-        valid = false;
-        break;
-      }
+// Picks the k-th free cell uniformly, skipping whole words by popcount, so
+// placement stays bounded however full the grid gets.
+static void snakePlaceFood(MgContext& ctx) {
+  uint16_t k = mgRandom(ctx, SNAKE_CELLS - snState.length);
+  uint16_t cell = 0;
+  for (uint8_t w = 0; w < SNAKE_WORDS; w++) {
+    uint32_t bits = (w == SNAKE_CELLS / 32) ? (1UL << (SNAKE_CELLS % 32)) - 1 : 0xFFFFFFFFUL;
+    uint32_t free = ~snState.occupied[w] & bits;
+    uint8_t n = __builtin_popcount(free);
+    if (k >= n) {
+      k -= n;
+      continue;
     }
-  } while (!valid);
-  snState.foodColor = random(MANA_COLOR_COUNT);
+    while (k--) free &= free - 1;
+    cell = w * 32 + __builtin_ctz(free);
+    break;
+  }
+  snState.foodX = cell % SNAKE_COLS;
+  snState.foodY = cell / SNAKE_COLS;
+  snState.foodColor = mgRandom(ctx, MANA_COLOR_COUNT);
 }
 
-static void snakeInit() {
+static void snakeInit(MgContext& ctx) {
   memset(&snState, 0, sizeof(snState));
   snState.length = 3;
   snState.dirX = 1;
   snState.dirY = 0;
   snState.alive = true;
   snState.moveIntervalMs = 200;
-  snState.lastMoveMs = millis();
 
 
   for (int i = 0; i < 3; i++) {
-    snState.bodyX[i] = SNAKE_COLS / 2 - i;
-    snState.bodyY[i] = SNAKE_ROWS / 2;
+    uint16_t cell = (SNAKE_ROWS / 2) * SNAKE_COLS + SNAKE_COLS / 2 - i;
+    snState.body[i] = cell;
+    snakeSetOccupied(cell, true);
   }
 
-  snakePlaceFood();
+  snakePlaceFood(ctx);
 }
 
-static void snakeUpdate(const JoystickState& js) {
+static void snakeUpdate(MgContext& ctx, const JoystickState& js) {
   if (!snState.alive) return;
+  unsigned long now = ctx.nowMs;
 
   int8_t dx = joystickDirX(js);
   int8_t dy = joystickDirY(js);
@@ -390,45 +380,47 @@ static void snakeUpdate(const JoystickState& js) {
   }
 
 
-  if (millis() - snState.lastMoveMs < snState.moveIntervalMs) return;
-  snState.lastMoveMs = millis();
+  if (now - snState.lastMoveMs < snState.moveIntervalMs) return;
+  snState.lastMoveMs = now;
 
 
-  int8_t newX = snState.bodyX[0] + snState.dirX;
-  int8_t newY = snState.bodyY[0] + snState.dirY;
+  uint16_t headCell = snakeSegment(snState, 0);
+  int8_t newX = headCell % SNAKE_COLS + snState.dirX;
+  int8_t newY = headCell / SNAKE_COLS + snState.dirY;
 
   if (newX < 0) newX = SNAKE_COLS - 1;
   if (newX >= SNAKE_COLS) newX = 0;
   if (newY < 0) newY = SNAKE_ROWS - 1;
   if (newY >= SNAKE_ROWS) newY = 0;
-
-
-  for (int i = 0; i < snState.length; i++) {
-    if (snState.bodyX[i] == newX && snState.bodyY[i] == newY) {
-      snState.alive = false;
-      audioGameOver();
-      return;
-    }
-  }
+  uint16_t newCell = newY * SNAKE_COLS + newX;
 
 
   bool ate = (newX == snState.foodX && newY == snState.foodY);
 
-  int newLen = ate ? snState.length + 1 : snState.length;
-  if (newLen > SNAKE_MAX_LEN) newLen = SNAKE_MAX_LEN;
+  // The tail moves out of the way this step unless the snake grows.
+  if (!ate) snakeSetOccupied(snakeSegment(snState, snState.length - 1), false);
 
-  for (int i = newLen - 1; i > 0; i--) {
-    snState.bodyX[i] = snState.bodyX[i - 1];
-    snState.bodyY[i] = snState.bodyY[i - 1];
+  if (snakeOccupied(newCell)) {
+    snState.alive = false;
+    mgSound(ctx, MG_SFX_GAME_OVER);
+    return;
   }
-  snState.bodyX[0] = newX;
-  snState.bodyY[0] = newY;
-  snState.length = newLen;
+
+  snState.head = (snState.head + SNAKE_MAX_LEN - 1) % SNAKE_MAX_LEN;
+  snState.body[snState.head] = newCell;
+  snakeSetOccupied(newCell, true);
 
   if (ate) {
+    snState.length++;
     snState.score += 10;
-    audioGamePoint();
-    snakePlaceFood();
+    mgSound(ctx, MG_SFX_POINT);
+
+    if (snState.length == SNAKE_CELLS) {
+      snState.won = true;
+      snState.alive = false;
+      return;
+    }
+    snakePlaceFood(ctx);
 
 
     if (snState.moveIntervalMs > 80) {
@@ -437,202 +429,172 @@ static void snakeUpdate(const JoystickState& js) {
   }
 }
 
-static void snakeRender() {
-  M5Canvas& spr = displayGetSprite();
-  displayBeginDraw();
-
-
-  spr.setTextSize(1);
-  spr.setTextColor(COLOR_TEXT, COLOR_BG);
-  spr.setCursor(5, 3);
-  spr.print("Snake");
-  char buf[16];
-  snprintf(buf, sizeof(buf), "Score: %d", snState.score);
-  spr.setCursor(160, 3);
-  spr.print(buf);
-
-  spr.drawFastHLine(0, SNAKE_OFFSET_Y - 1, SCREEN_W, COLOR_DIVIDER);
-
-  if (!snState.alive) {
-    displayMiniGameOver(snState.score);
-    return;
-  }
-
-
-  for (int x = 0; x < SNAKE_COLS; x++) {
-    for (int y = 0; y < SNAKE_ROWS; y++) {
-      int px = x * SNAKE_CELL;
-      int py = SNAKE_OFFSET_Y + y * SNAKE_CELL;
-      spr.drawPixel(px, py, GRID_DOT_COLOR);
-    }
-  }
 
+static void spellDodgeSpawn(MgContext& ctx, float y) {
+  SDSpells& sp = sdState.spells;
+  int16_t id = sp.pool.spawn();
+  if (id < 0) return;
+  sp.x[id] = mgRandom(ctx, SCREEN_W - 8);
+  sp.y[id] = y;
+  sp.prevY[id] = sp.y[id];
+  sp.colorIdx[id] = mgRandom(ctx, MANA_COLOR_COUNT);
+}
 
-  int fx = snState.foodX * SNAKE_CELL + SNAKE_CELL / 2;
-  int fy = SNAKE_OFFSET_Y + snState.foodY * SNAKE_CELL + SNAKE_CELL / 2;
-  spr.fillCircle(fx, fy, 4, MANA_COLORS[snState.foodColor]);
-  spr.drawCircle(fx, fy, 4, COLOR_TEXT);
-
-
-  for (int i = 0; i < snState.length; i++) {
-    int sx = snState.bodyX[i] * SNAKE_CELL + 1;
-    int sy = SNAKE_OFFSET_Y + snState.bodyY[i] * SNAKE_CELL + 1;
-    uint16_t color = (i == 0) ? MTG_WHITE : MTG_GREEN;
-    spr.fillRect(sx, sy, SNAKE_CELL - 2, SNAKE_CELL - 2, color);
-  }
-
-  displayEndDraw();
+// Spread over the whole field rather than queued at the top edge.
+static void spellDodgeFill(MgContext& ctx) {
+  while (sdState.spells.pool.count < SD_MAX_SPELLS) spellDodgeSpawn(ctx, 14 + mgRandom(ctx, SCREEN_H - 14));
 }
 
-static void spellDodgeInit() {
+static void spellDodgeInit(MgContext&) {
   memset(&sdState, 0, sizeof(sdState));
+  sdState.spells.pool.clear();
   sdState.playerX = SCREEN_W / 2 - SD_PLAYER_W / 2;
+  sdState.prevPlayerX = sdState.playerX;
   sdState.lives = 3;
-  sdState.spellSpeed = 1.5f;
+  sdState.spellSpeed = SD_BASE_SPEED;
   sdState.alive = true;
-  sdState.startMs = millis();
-  sdState.lastSpawnMs = millis();
 }
 
-static void spellDodgeUpdate(const JoystickState& js) {
+static void spellDodgeUpdate(MgContext& ctx, const JoystickState& js) {
   if (!sdState.alive) return;
+  unsigned long now = ctx.nowMs;
 
+  sdState.prevPlayerX = sdState.playerX;
+  SDSpells& sp = sdState.spells;
 
-  int8_t dx = joystickDirX(js);
-  sdState.playerX += dx * 4.0f;
+  sdState.playerX += joystickAxisX(js) * SD_PLAYER_SPEED * MG_DT;
   if (sdState.playerX < 0) sdState.playerX = 0;
   if (sdState.playerX > SCREEN_W - SD_PLAYER_W) sdState.playerX = SCREEN_W - SD_PLAYER_W;
 
 
-  unsigned long elapsed = millis() - sdState.startMs;
-  sdState.spellSpeed = 1.5f + elapsed / 8000.0f;
-  if (sdState.spellSpeed > 5.0f) sdState.spellSpeed = 5.0f;
+  unsigned long elapsed = now - sdState.startMs;
+  sdState.spellSpeed = SD_BASE_SPEED + elapsed / 400.0f;
+  if (sdState.spellSpeed > SD_MAX_SPEED) sdState.spellSpeed = SD_MAX_SPEED;
 
 
   unsigned long spawnBase = (elapsed / 20 < 500) ? (500 - elapsed / 20) : 0;
   unsigned long spawnInterval = (spawnBase > 200) ? spawnBase : 200;
-  if (millis() - sdState.lastSpawnMs > spawnInterval) {
-    sdState.lastSpawnMs = millis();
-    for (int i = 0; i < SD_MAX_SPELLS; i++) {
-      if (!sdState.spells[i].active) {
-        sdState.spells[i].active = true;
-        sdState.spells[i].x = random(SCREEN_W - 8);
-        sdState.spells[i].y = 14;
-        sdState.spells[i].colorIdx = random(MANA_COLOR_COUNT);
-        break;
-      }
-    }
+  if (now - sdState.lastSpawnMs > spawnInterval) {
+    sdState.lastSpawnMs = now;
+    spellDodgeSpawn(ctx, 14);
   }
 
   float py = SCREEN_H - 20;
 
 
-  for (int i = 0; i < SD_MAX_SPELLS; i++) {
-    if (!sdState.spells[i].active) continue;
-    sdState.spells[i].y += sdState.spellSpeed;
+  mgGrid.begin();
+  for (uint16_t k = sp.pool.count; k-- > 0;) {
+    uint16_t id = sp.pool.dense[k];
+    sp.prevY[id] = sp.y[id];
+    sp.y[id] += sdState.spellSpeed * MG_DT;
 
 
-    if (sdState.spells[i].y > SCREEN_H) {
-      sdState.spells[i].active = false;
+    if (sp.y[id] > SCREEN_H) {
+      sp.pool.kill(id);
       sdState.score++;
       continue;
     }
-
-
-    float sx = sdState.spells[i].x;
-    float sy = sdState.spells[i].y;
-    if (sx + 8 > sdState.playerX && sx < sdState.playerX + SD_PLAYER_W &&
+    mgGrid.add(id, sp.x[id], sp.y[id]);
+  }
+  mgGrid.build();
+
+  // Spells are 8x8 boxes anchored at their top-left corner, so any spell
+  // touching the player has its anchor inside this box.
+  int hitId = -1;
+  mgGrid.query(sdState.playerX - 8, py - 8, sdState.playerX + SD_PLAYER_W, py + SD_PLAYER_H,
+               [&](uint16_t id) {
+    float sx = sp.x[id];
+    float sy = sp.y[id];
+    if (hitId < 0 && sx + 8 > sdState.playerX && sx < sdState.playerX + SD_PLAYER_W &&
         sy + 8 > py && sy < py + SD_PLAYER_H) {
-      sdState.spells[i].active = false;
-      sdState.lives--;
-      audioGameHit();
-      if (sdState.lives == 0) {
-        sdState.alive = false;
-        audioGameOver();
-        return;
-      }
+      hitId = id;
+    }
+  });
+
+  if (hitId >= 0) {
+    sp.pool.kill(hitId);
+    sdState.lives--;
+    mgSound(ctx, MG_SFX_HIT);
+    if (sdState.lives == 0) {
+      sdState.alive = false;
+      mgSound(ctx, MG_SFX_GAME_OVER);
     }
   }
 }
 
-static void spellDodgeRender() {
-  M5Canvas& spr = displayGetSprite();
-  displayBeginDraw();
-
+static bool manaRunnerAlive() { return mrState.alive; }
+static bool arenaAlive() { return abState.alive; }
+static bool snakeAlive() { return snState.alive; }
+static bool spellDodgeAlive() { return sdState.alive; }
 
-  spr.setTextSize(1);
-  spr.setTextColor(COLOR_TEXT, COLOR_BG);
-  spr.setCursor(5, 3);
-  spr.print("Spell Dodge");
+static uint16_t manaRunnerScore() { return mrState.score; }
+static uint16_t arenaScore() { return abState.score; }
+static uint16_t snakeScore() { return snState.score; }
+static uint16_t spellDodgeScore() { return sdState.score; }
 
+static uint16_t manaRunnerEntities() { return mrState.obstacles.pool.count + mrState.mana.pool.count; }
+static uint16_t arenaEntities() { return abState.enemies.pool.count; }
+static uint16_t snakeEntities() { return snState.length; }
+static uint16_t spellDodgeEntities() { return sdState.spells.pool.count; }
 
-  for (int i = 0; i < sdState.lives; i++) {
-    spr.fillCircle(150 + i * 14, 6, 4, MTG_RED);
-  }
-
-  char buf[16];
-  snprintf(buf, sizeof(buf), "%d", sdState.score);
-  spr.setCursor(210, 3);
-  spr.print(buf);
-
-  spr.drawFastHLine(0, 13, SCREEN_W, COLOR_DIVIDER);
-
-  if (!sdState.alive) {
-    displayMiniGameOver(sdState.score);
-    return;
-  }
-
+static void manaRunnerPlayer(int16_t& x, int16_t& y) {
+  x = 30 + MR_PLAYER_SIZE / 2;
+  y = (int16_t)mrState.playerY + MR_PLAYER_SIZE / 2;
+}
 
-  for (int i = 0; i < SD_MAX_SPELLS; i++) {
-    if (!sdState.spells[i].active) continue;
-    spr.fillRect((int)sdState.spells[i].x, (int)sdState.spells[i].y, 8, 8,
-                 MANA_COLORS[sdState.spells[i].colorIdx]);
-  }
+static void arenaPlayer(int16_t& x, int16_t& y) {
+  x = (int16_t)abState.playerX + 3;
+  y = (int16_t)abState.playerY + 3;
+}
 
-  float py = SCREEN_H - 20;
-  spr.fillRect((int)sdState.playerX, (int)py, SD_PLAYER_W, SD_PLAYER_H, MTG_WHITE);
-  spr.drawRect((int)sdState.playerX, (int)py, SD_PLAYER_W, SD_PLAYER_H, MTG_BLUE);
+static void snakePlayer(int16_t& x, int16_t& y) {
+  uint16_t cell = snakeSegment(snState, 0);
+  x = (cell % SNAKE_COLS) * SNAKE_CELL + SNAKE_CELL / 2;
+  y = SNAKE_OFFSET_Y + (cell / SNAKE_COLS) * SNAKE_CELL + SNAKE_CELL / 2;
+}
 
-  displayEndDraw();
+static void spellDodgePlayer(int16_t& x, int16_t& y) {
+  x = (int16_t)sdState.playerX + SD_PLAYER_W / 2;
+  y = SCREEN_H - 20 + SD_PLAYER_H / 2;
 }
 
-void mgInit(AppState game) {
-  switch (game) {
-    case STATE_GAME_MANA_RUNNER: manaRunnerInit(); break;
-    case STATE_GAME_ARENA:       arenaInit();      break;
-    case STATE_GAME_SNAKE:       snakeInit();      break;
-    case STATE_GAME_SPELL_DODGE: spellDodgeInit(); break;
-    default: break;
-  }
+#ifdef MG_HEADLESS
+#define MG_RENDER(fn) nullptr
+#else
+#define MG_RENDER(fn) fn
+#endif
+
+// Indexed by AppState - STATE_GAME_MANA_RUNNER.
+const MiniGame MINIGAMES[MINIGAME_COUNT] = {
+  { "Mana Runner", manaRunnerInit, manaRunnerUpdate, MG_RENDER(mgRenderManaRunner), manaRunnerAlive,
+    manaRunnerScore, manaRunnerEntities, manaRunnerPlayer, nullptr, &mrState, sizeof(mrState) },
+  { "Arena Battle", arenaInit, arenaUpdate, MG_RENDER(mgRenderArena), arenaAlive,
+    arenaScore, arenaEntities, arenaPlayer, arenaFill, &abState, sizeof(abState) },
+  { "Snake", snakeInit, snakeUpdate, MG_RENDER(mgRenderSnake), snakeAlive,
+    snakeScore, snakeEntities, snakePlayer, nullptr, &snState, sizeof(snState) },
+  { "Spell Dodge", spellDodgeInit, spellDodgeUpdate, MG_RENDER(mgRenderSpellDodge), spellDodgeAlive,
+    spellDodgeScore, spellDodgeEntities, spellDodgePlayer, spellDodgeFill, &sdState, sizeof(sdState) },
+};
+
+const MiniGame* mgFind(AppState game) {
+  if (game < STATE_GAME_MANA_RUNNER || game > STATE_GAME_SPELL_DODGE) return nullptr;
+  return &MINIGAMES[game - STATE_GAME_MANA_RUNNER];
 }
 
-void mgUpdate(AppState game, const JoystickState& js) {
-  switch (game) {
-    case STATE_GAME_MANA_RUNNER: manaRunnerUpdate(js); break;
-    case STATE_GAME_ARENA:       arenaUpdate(js);      break;
-    case STATE_GAME_SNAKE:       snakeUpdate(js);      break;
-    case STATE_GAME_SPELL_DODGE: spellDodgeUpdate(js); break;
-    default: break;
-  }
+void mgStart(const MiniGame& game, MgContext& ctx, uint32_t seed) {
+  ctx.tick = 0;
+  ctx.nowMs = 0;
+  prngStateSeed(ctx.rng, seed, PRNG_MINIGAME);
+  game.init(ctx);
 }
 
-void mgRender(AppState game) {
-  switch (game) {
-    case STATE_GAME_MANA_RUNNER: manaRunnerRender(); break;
-    case STATE_GAME_ARENA:       arenaRender();      break;
-    case STATE_GAME_SNAKE:       snakeRender();      break;
-    case STATE_GAME_SPELL_DODGE: spellDodgeRender(); break;
-    default: break;
-  }
+void mgStep(const MiniGame& game, MgContext& ctx, const JoystickState& js) {
+  ctx.tick++;
+  ctx.nowMs = (unsigned long)((uint64_t)ctx.tick * MG_TICK_US / 1000);
+  game.tick(ctx, js);
 }
 
 bool mgIsAlive(AppState game) {
-  switch (game) {
-    case STATE_GAME_MANA_RUNNER: return mrState.alive;
-    case STATE_GAME_ARENA:       return abState.alive;
-    case STATE_GAME_SNAKE:       return snState.alive;
-    case STATE_GAME_SPELL_DODGE: return sdState.alive;
-    default: return false;
-  }
+  const MiniGame* mg = mgFind(game);
+  return mg && mg->alive();
 }
-
@@ -3,6 +3,22 @@
 
 #include "config.h"
 #include "joystick.h"
+#include "entity_pool.h"
+#include "prng.h"
+#include "mgrecord.h"
+
+// Game logic runs in fixed MG_TICK_HZ ticks driven by an accumulator, so
+// speeds below are in pixels per second and timers use the tick clock in
+// MgContext instead of millis(). Rendering interpolates between the
+// previous and current tick by the leftover fraction of a tick.
+#define MG_TICK_HZ         120
+#define MG_TICK_US         (1000000UL / MG_TICK_HZ)
+#define MG_DT              (1.0f / MG_TICK_HZ)
+#define MG_MAX_FRAME_US    100000UL
+#define MG_GRID_MAX_ITEMS  256
+#define MG_GRID_CELL_SHIFT 4
+#define MINIGAME_COUNT     (STATE_GAME_SPELL_DODGE - STATE_GAME_MANA_RUNNER + 1)
+#define MANA_COLOR_COUNT   5
 
 #define MR_MAX_OBSTACLES 6
 #define MR_MAX_MANA 4
@@ -10,23 +26,28 @@
 #define MR_PLAY_Y 14
 #define MR_PLAY_H 121
 
-struct MRObstacle {
-  float x;
-  uint8_t gapY;
-  uint8_t gapSize;
-  bool active;
+#define MR_PLAYER_SPEED 60.0f
+#define MR_BASE_SPEED   40.0f
+#define MR_MAX_SPEED    120.0f
+
+// Entity components are stored struct-of-arrays, indexed by pool id.
+struct MRObstacles {
+  EntityPool<MR_MAX_OBSTACLES> pool;
+  float x[MR_MAX_OBSTACLES], prevX[MR_MAX_OBSTACLES];
+  uint8_t gapY[MR_MAX_OBSTACLES];
+  uint8_t gapSize[MR_MAX_OBSTACLES];
 };
 
 struct MRMana {
-  float x, y;
-  uint8_t colorIdx;
-  bool active;
+  EntityPool<MR_MAX_MANA> pool;
+  float x[MR_MAX_MANA], prevX[MR_MAX_MANA], y[MR_MAX_MANA];
+  uint8_t colorIdx[MR_MAX_MANA];
 };
 
 struct ManaRunnerState {
-  float playerY;
-  MRObstacle obstacles[MR_MAX_OBSTACLES];
-  MRMana mana[MR_MAX_MANA];
+  float playerY, prevPlayerY;
+  MRObstacles obstacles;
+  MRMana mana;
   uint16_t score;
   float speed;
   bool alive;
@@ -34,20 +55,27 @@ struct ManaRunnerState {
   unsigned long startMs;
 };
 
-#define AB_MAX_ENEMIES 10
+#define AB_MAX_ENEMIES 256
 #define AB_PLAY_Y 14
 #define AB_PLAY_H 121
+#define AB_PLAYER_SPEED 60.0f
+#define AB_ENEMY_BASE_SPEED 16.0f
+#define AB_ENEMY_WAVE_SPEED 4.0f
+#define AB_ENEMY_MAX_SPEED 60.0f
+#define AB_ENEMY_SPACING 6.0f
+#define AB_ATTACK_RADIUS 20
 
-struct ABEnemy {
-  float x, y;
-  float dx, dy;
-  uint8_t colorIdx;
-  bool alive;
+struct ABEnemies {
+  EntityPool<AB_MAX_ENEMIES> pool;
+  float x[AB_MAX_ENEMIES], y[AB_MAX_ENEMIES];
+  float prevX[AB_MAX_ENEMIES], prevY[AB_MAX_ENEMIES];
+  uint8_t colorIdx[AB_MAX_ENEMIES];
 };
 
 struct ArenaBattleState {
   float playerX, playerY;
-  ABEnemy enemies[AB_MAX_ENEMIES];
+  float prevPlayerX, prevPlayerY;
+  ABEnemies enemies;
   uint8_t hp;
   uint16_t score;
   uint8_t wave;
@@ -61,35 +89,53 @@ struct ArenaBattleState {
 #define SNAKE_CELL 10
 #define SNAKE_COLS 24
 #define SNAKE_ROWS 12
-#define SNAKE_MAX_LEN 80
+#define SNAKE_CELLS (SNAKE_COLS * SNAKE_ROWS)
+#define SNAKE_WORDS ((SNAKE_CELLS + 31) / 32)
+#define SNAKE_MAX_LEN SNAKE_CELLS
 #define SNAKE_OFFSET_Y 14
 
+// The body is a ring buffer of cell indices (y * SNAKE_COLS + x) with the
+// head at body[head] and the tail length - 1 slots after it, so a move
+// only writes the new head. occupied[] has one bit per grid cell.
 struct SnakeState {
-  uint8_t bodyX[SNAKE_MAX_LEN];
-  uint8_t bodyY[SNAKE_MAX_LEN];
-  uint8_t length;
+  uint16_t body[SNAKE_MAX_LEN];
+  uint16_t head;
+  uint16_t length;
+  uint32_t occupied[SNAKE_WORDS];
   int8_t dirX, dirY;
   uint8_t foodX, foodY;
   uint8_t foodColor;
   uint16_t score;
   bool alive;
+  bool won;
   unsigned long lastMoveMs;
   uint16_t moveIntervalMs;
 };
 
-#define SD_MAX_SPELLS 12
+static inline uint16_t snakeSegment(const SnakeState& s, uint16_t i) {
+  return s.body[(s.head + i) % SNAKE_MAX_LEN];
+}
+
+static inline bool snakeCellSet(const uint32_t* bits, uint16_t cell) {
+  return bits[cell >> 5] & (1UL << (cell & 31));
+}
+
+#define SD_MAX_SPELLS 256
 #define SD_PLAYER_W 12
 #define SD_PLAYER_H 8
+#define SD_PLAYER_SPEED 80.0f
+#define SD_BASE_SPEED 30.0f
+#define SD_MAX_SPEED 100.0f
 
-struct SDSpell {
-  float x, y;
-  uint8_t colorIdx;
-  bool active;
+struct SDSpells {
+  EntityPool<SD_MAX_SPELLS> pool;
+  float x[SD_MAX_SPELLS], y[SD_MAX_SPELLS], prevY[SD_MAX_SPELLS];
+  uint8_t colorIdx[SD_MAX_SPELLS];
 };
 
 struct SpellDodgeState {
-  float playerX;
-  SDSpell spells[SD_MAX_SPELLS];
+  float playerX, prevPlayerX;
+  SDSpells spells;
   uint8_t lives;
   uint16_t score;
   float spellSpeed;
@@ -98,9 +144,97 @@ struct SpellDodgeState {
   bool alive;
 };
 
-void mgInit(AppState game);
-void mgUpdate(AppState game, const JoystickState& js);
-void mgRender(AppState game);
+enum MgSound : uint8_t {
+  MG_SFX_POINT,
+  MG_SFX_HIT,
+  MG_SFX_ATTACK,
+  MG_SFX_GAME_OVER
+};
+
+// Everything a game reads from outside is injected here: the tick clock,
+// its own random stream and the sound sink (nullptr when muted). The same
+// logic then runs on the device and in the headless host runner.
+struct MgContext {
+  uint32_t tick;
+  unsigned long nowMs;
+  PrngState rng;
+  void (*sound)(MgSound sfx);
+};
+
+// state/stateSize expose the game's global state so a second instance
+// (the replay ghost) can be swapped in around its own ticks. player()
+// reports the centre of the player in screen pixels and entities() the
+// number of live objects, for the soak statistics. fill(), where set,
+// spawns until every entity pool is at capacity, for stress runs.
+struct MiniGame {
+  const char* name;
+  void (*init)(MgContext& ctx);
+  void (*tick)(MgContext& ctx, const JoystickState& js);
+  void (*render)(const MgContext& ctx, float alpha);
+  bool (*alive)();
+  uint16_t (*score)();
+  uint16_t (*entities)();
+  void (*player)(int16_t& x, int16_t& y);
+  void (*fill)(MgContext& ctx);
+  void* state;
+  uint16_t stateSize;
+};
+
+extern const MiniGame MINIGAMES[MINIGAME_COUNT];
+
+extern ManaRunnerState mrState;
+extern ArenaBattleState abState;
+extern SnakeState snState;
+extern SpellDodgeState sdState;
+
+enum MgMode : uint8_t {
+  MG_MODE_PLAY,
+  MG_MODE_GHOST,  // race the run in mgGhostSlot()
+  MG_MODE_SOAK,   // autoplay bots, restart on game over, collect MgSoakStats
+  MG_MODE_STRESS  // soak with the entity pools refilled to capacity every tick
+};
+
+// Collected while soaking. Frame times are the gaps between mgFrame()
+// calls; heapMin is the lowest free heap since boot and stackFreeMin the
+// least loop task stack ever left unused, both as reported by the RTOS.
+struct MgSoakStats {
+  unsigned long startMs;
+  uint32_t runs;
+  uint32_t frames;
+  uint64_t frameUsTotal;
+  uint32_t frameUsMax;
+  uint16_t entitiesMax;
+  uint16_t bestScore;
+  uint32_t heapFree;
+  uint32_t heapMin;
+  uint32_t stackFreeMin;
+};
+
+// How a run ended. rec is the input recording, or nullptr if the run was
+// too long to fit in MG_REC_BYTES.
+struct MgRunResult {
+  uint8_t game;
+  uint16_t score;
+  uint32_t ticks;
+  uint32_t seed;
+  const MgRecording* rec;
+};
+
+const MiniGame* mgFind(AppState game);
+void mgStart(const MiniGame& game, MgContext& ctx, uint32_t seed);
+void mgStep(const MiniGame& game, MgContext& ctx, const JoystickState& js);
 bool mgIsAlive(AppState game);
 
+// Device side, in minigames_render.cpp.
+void mgRenderManaRunner(const MgContext& ctx, float alpha);
+void mgRenderArena(const MgContext& ctx, float alpha);
+void mgRenderSnake(const MgContext& ctx, float alpha);
+void mgRenderSpellDodge(const MgContext& ctx, float alpha);
+void mgInit(AppState game, MgMode mode = MG_MODE_PLAY);
+void mgFrame(AppState game, const JoystickState& js);
+MgRecording& mgGhostSlot();
+bool mgFinishedRun(MgRunResult& run);
+bool mgSoaking();
+const MgSoakStats& mgSoakStats();
+
 #endif
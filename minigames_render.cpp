@@ -0,0 +1,510 @@
+#include "minigames.h"
+#include "display.h"
+#include "audio.h"
+#include "sprites.h"
+#include "mgbot.h"
+#include <Arduino.h>
+
+static_assert(SPR_MANA_VARIANTS == MANA_COLOR_COUNT, "regenerate sprites.h after changing the mana palette");
+
+#define GRID_DOT_COLOR    0x1082
+#define SOAK_REFRESH_MS   1000
+
+// What the panel currently shows for Snake, so frames can repaint only
+// the cells that changed.
+struct SnakeDrawn {
+  uint32_t occupied[SNAKE_WORDS];
+  uint16_t head;
+  uint16_t food;
+  uint16_t ghost;
+  uint16_t score;
+  bool valid;
+};
+
+// Storage for a second instance of any game's state, used by the ghost.
+union MgAnyState {
+  ManaRunnerState mr;
+  ArenaBattleState ab;
+  SnakeState sn;
+  SpellDodgeState sd;
+};
+
+// The ghost replays the best stored run of the same game from the same
+// seed, in lockstep with the live run. Only its player is drawn.
+struct MgGhost {
+  MgRecording rec;
+  MgPlayer player;
+  MgContext ctx;
+  MgAnyState state;
+  int16_t x, y, prevX, prevY;
+  bool active;
+};
+
+static SnakeDrawn snakeDrawn;
+static MgContext mgCtx;
+static const MiniGame* mgActive = nullptr;
+static unsigned long frameLastUs = 0;
+static uint32_t frameAccumUs = 0;
+static MgRecording liveRec;
+static MgRecorder recorder;
+static bool runReported = true;
+static MgGhost ghost;
+static bool soakMode = false;
+static bool stressMode = false;
+static MgSoakStats soak;
+static char soakText[48];
+static bool soakDirty = false;
+static unsigned long soakRefreshMs = 0;
+
+static inline int lerpPx(float prev, float cur, float alpha) {
+  return (int)(prev + (cur - prev) * alpha);
+}
+
+// Ghost position at this frame, or false when there is no ghost to draw.
+static bool ghostPos(float alpha, int& x, int& y) {
+  if (!ghost.active) return false;
+  x = lerpPx(ghost.prevX, ghost.x, alpha);
+  y = lerpPx(ghost.prevY, ghost.y, alpha);
+  return true;
+}
+
+static void drawGhost(float alpha) {
+  int gx, gy;
+  if (ghostPos(alpha, gx, gy)) displayBlit(SPR_GHOST, gx - 4, gy - 4);
+}
+
+// While soaking the header shows the running statistics instead of the
+// game's title and score.
+static void soakDrawHeader(M5Canvas& spr) {
+  if (!soakMode) return;
+  spr.fillRect(0, 0, SCREEN_W, SNAKE_OFFSET_Y - 1, COLOR_BG);
+  spr.setTextSize(1);
+  spr.setTextColor(COLOR_TEXT, COLOR_BG);
+  spr.setCursor(2, 3);
+  spr.print(soakText);
+  soakDirty = false;
+}
+
+static void drawOverlays(float alpha) {
+  drawGhost(alpha);
+  soakDrawHeader(displayGetSprite());
+}
+
+static void mgPlaySound(MgSound sfx) {
+  switch (sfx) {
+    case MG_SFX_POINT:     audioGamePoint();  break;
+    case MG_SFX_HIT:       audioGameHit();    break;
+    case MG_SFX_ATTACK:    audioGameAttack(); break;
+    case MG_SFX_GAME_OVER: audioGameOver();   break;
+  }
+}
+
+void mgRenderManaRunner(const MgContext&, float alpha) {
+  M5Canvas& spr = displayGetSprite();
+  displayBeginDraw();
+
+
+  spr.setTextSize(1);
+  spr.setTextColor(COLOR_TEXT, COLOR_BG);
+  spr.setCursor(5, 3);
+  spr.print("Mana Runner");
+  char buf[16];
+  snprintf(buf, sizeof(buf), "Score: %d", mrState.score);
+  spr.setCursor(160, 3);
+  spr.print(buf);
+
+
+  spr.drawFastHLine(0, MR_PLAY_Y - 1, SCREEN_W, COLOR_DIVIDER);
+
+  if (!mrState.alive) {
+    displayMiniGameOver(mrState.score);
+    return;
+  }
+
+
+  const MRObstacles& o = mrState.obstacles;
+  for (uint16_t k = 0; k < o.pool.count; k++) {
+    uint16_t id = o.pool.dense[k];
+    int ox = lerpPx(o.prevX[id], o.x[id], alpha);
+    int gapTop = o.gapY[id] - o.gapSize[id] / 2;
+    int gapBot = o.gapY[id] + o.gapSize[id] / 2;
+
+
+    if (gapTop > MR_PLAY_Y)
+      spr.fillRect(ox, MR_PLAY_Y, 12, gapTop - MR_PLAY_Y, MTG_RED);
+
+    if (gapBot < MR_PLAY_Y + MR_PLAY_H)
+      spr.fillRect(ox, gapBot, 12, MR_PLAY_Y + MR_PLAY_H - gapBot, MTG_RED);
+  }
+
+
+  const MRMana& m = mrState.mana;
+  for (uint16_t k = 0; k < m.pool.count; k++) {
+    uint16_t id = m.pool.dense[k];
+    displayBlit(SPR_MANA_ORB + m.colorIdx[id], lerpPx(m.prevX[id], m.x[id], alpha) - 4, (int)m.y[id] - 4);
+  }
+
+  int py = lerpPx(mrState.prevPlayerY, mrState.playerY, alpha);
+  displayBlit(SPR_RUNNER, 30, py);
+
+  drawOverlays(alpha);
+  displayEndDraw();
+}
+
+void mgRenderArena(const MgContext& ctx, float alpha) {
+  M5Canvas& spr = displayGetSprite();
+  displayBeginDraw();
+
+
+  spr.setTextSize(1);
+  spr.setTextColor(COLOR_TEXT, COLOR_BG);
+  spr.setCursor(5, 3);
+  char buf[24];
+  snprintf(buf, sizeof(buf), "HP:%d  Wave:%d", abState.hp, abState.wave);
+  spr.print(buf);
+  snprintf(buf, sizeof(buf), "Score: %d", abState.score);
+  spr.setCursor(160, 3);
+  spr.print(buf);
+
+  spr.drawFastHLine(0, AB_PLAY_Y - 1, SCREEN_W, COLOR_DIVIDER);
+
+  if (!abState.alive) {
+    displayMiniGameOver(abState.score);
+    return;
+  }
+
+
+  const ABEnemies& e = abState.enemies;
+  for (uint16_t k = 0; k < e.pool.count; k++) {
+    uint16_t id = e.pool.dense[k];
+    displayBlit(SPR_ENEMY + e.colorIdx[id], lerpPx(e.prevX[id], e.x[id], alpha), lerpPx(e.prevY[id], e.y[id], alpha));
+  }
+
+
+  int px = lerpPx(abState.prevPlayerX, abState.playerX, alpha) + 3;
+  int py = lerpPx(abState.prevPlayerY, abState.playerY, alpha) + 3;
+  if (abState.attacking) {
+    uint16_t attackColor = 0xFEA0;
+    spr.drawCircle(px, py, 18, attackColor);
+    spr.drawCircle(px, py, 20, attackColor);
+  }
+
+  unsigned long now = ctx.nowMs;
+  bool invincible = (abState.lastHitMs > 0 && now - abState.lastHitMs < 1000);
+  if (!invincible || (now / 100) % 2 == 0) {
+    displayBlit(SPR_ARENA_PLAYER, px - 5, py - 5);
+  }
+
+  drawOverlays(alpha);
+  displayEndDraw();
+}
+
+static void snakeDrawHeader(M5Canvas& spr) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "Score: %d", snState.score);
+  spr.fillRect(160, 0, SCREEN_W - 160, SNAKE_OFFSET_Y - 1, COLOR_BG);
+  spr.setTextSize(1);
+  spr.setTextColor(COLOR_TEXT, COLOR_BG);
+  spr.setCursor(160, 3);
+  spr.print(buf);
+}
+
+// Each tile owns its whole SNAKE_CELL square, so it can be repainted on
+// its own without touching its neighbours.
+#define SNAKE_NO_CELL 0xFFFF
+
+static uint16_t snakeGhostCell() {
+  int gx, gy;
+  if (!ghostPos(1.0f, gx, gy)) return SNAKE_NO_CELL;
+  return ((gy - SNAKE_OFFSET_Y) / SNAKE_CELL) * SNAKE_COLS + gx / SNAKE_CELL;
+}
+
+static void snakeDrawTile(M5Canvas& spr, uint16_t cell) {
+  int x = (cell % SNAKE_COLS) * SNAKE_CELL;
+  int y = SNAKE_OFFSET_Y + (cell / SNAKE_COLS) * SNAKE_CELL;
+  spr.fillRect(x, y, SNAKE_CELL, SNAKE_CELL, COLOR_BG);
+  spr.drawPixel(x, y, GRID_DOT_COLOR);
+
+  if (cell == snState.foodY * SNAKE_COLS + snState.foodX) {
+    displayBlit(SPR_FOOD + snState.foodColor, x + SNAKE_CELL / 2 - 4, y + SNAKE_CELL / 2 - 4);
+  }
+  if (snakeCellSet(snState.occupied, cell)) {
+    displayBlit((cell == snakeSegment(snState, 0)) ? SPR_SNAKE_HEAD : SPR_SNAKE_BODY, x + 1, y + 1);
+  }
+  if (cell == snakeGhostCell()) displayBlit(SPR_GHOST, x, y);
+}
+
+static void snakeMarkDrawn() {
+  memcpy(snakeDrawn.occupied, snState.occupied, sizeof(snakeDrawn.occupied));
+  snakeDrawn.head = snakeSegment(snState, 0);
+  snakeDrawn.food = snState.foodY * SNAKE_COLS + snState.foodX;
+  snakeDrawn.ghost = snakeGhostCell();
+  snakeDrawn.score = snState.score;
+}
+
+static void snakeDrawFull(M5Canvas& spr) {
+  displayBeginDraw();
+  spr.setTextSize(1);
+  spr.setTextColor(COLOR_TEXT, COLOR_BG);
+  spr.setCursor(5, 3);
+  spr.print("Snake");
+  snakeDrawHeader(spr);
+  soakDrawHeader(spr);
+  spr.drawFastHLine(0, SNAKE_OFFSET_Y - 1, SCREEN_W, COLOR_DIVIDER);
+  for (uint16_t cell = 0; cell < SNAKE_CELLS; cell++) snakeDrawTile(spr, cell);
+  displayEndDraw();
+}
+
+// A move changes only a few cells: the new head, the old head (white to
+// green), the vacated tail and the old and new food and ghost. Cells that
+// differ from what is on the panel are repainted in the sprite, and each
+// horizontal run of them is pushed as one rectangle.
+void mgRenderSnake(const MgContext&, float) {
+  M5Canvas& spr = displayGetSprite();
+
+  if (!snState.alive) {
+    displayMiniGameOver(snState.score, snState.won);
+    snakeDrawn.valid = false;
+    return;
+  }
+
+  if (!snakeDrawn.valid) {
+    snakeDrawFull(spr);
+    snakeMarkDrawn();
+    snakeDrawn.valid = true;
+    return;
+  }
+
+  uint32_t dirty[SNAKE_WORDS];
+  for (uint8_t w = 0; w < SNAKE_WORDS; w++) dirty[w] = snState.occupied[w] ^ snakeDrawn.occupied[w];
+  uint16_t marks[6] = {
+    snakeDrawn.head, snakeSegment(snState, 0), snakeDrawn.food, (uint16_t)(snState.foodY * SNAKE_COLS + snState.foodX),
+    snakeDrawn.ghost, snakeGhostCell()
+  };
+  for (uint8_t i = 0; i < 6; i++) {
+    if (marks[i] != SNAKE_NO_CELL) dirty[marks[i] >> 5] |= 1UL << (marks[i] & 31);
+  }
+
+  for (uint8_t row = 0; row < SNAKE_ROWS; row++) {
+    int8_t runStart = -1;
+    for (uint8_t col = 0; col <= SNAKE_COLS; col++) {
+      uint16_t cell = row * SNAKE_COLS + col;
+      bool isDirty = col < SNAKE_COLS && snakeCellSet(dirty, cell);
+      if (isDirty) {
+        snakeDrawTile(spr, cell);
+        if (runStart < 0) runStart = col;
+      } else if (runStart >= 0) {
+        displayPushRect(runStart * SNAKE_CELL, SNAKE_OFFSET_Y + row * SNAKE_CELL,
+                        (col - runStart) * SNAKE_CELL, SNAKE_CELL);
+        runStart = -1;
+      }
+    }
+  }
+
+  if (soakMode) {
+    if (soakDirty) {
+      soakDrawHeader(spr);
+      displayPushRect(0, 0, SCREEN_W, SNAKE_OFFSET_Y - 1);
+    }
+  } else if (snState.score != snakeDrawn.score) {
+    snakeDrawHeader(spr);
+    displayPushRect(160, 0, SCREEN_W - 160, SNAKE_OFFSET_Y - 1);
+  }
+  snakeMarkDrawn();
+}
+
+void mgRenderSpellDodge(const MgContext&, float alpha) {
+  M5Canvas& spr = displayGetSprite();
+  displayBeginDraw();
+
+
+  spr.setTextSize(1);
+  spr.setTextColor(COLOR_TEXT, COLOR_BG);
+  spr.setCursor(5, 3);
+  spr.print("Spell Dodge");
+
+
+  for (int i = 0; i < sdState.lives; i++) {
+    spr.fillCircle(150 + i * 14, 6, 4, MTG_RED);
+  }
+
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%d", sdState.score);
+  spr.setCursor(210, 3);
+  spr.print(buf);
+
+  spr.drawFastHLine(0, 13, SCREEN_W, COLOR_DIVIDER);
+
+  if (!sdState.alive) {
+    displayMiniGameOver(sdState.score);
+    return;
+  }
+
+
+  const SDSpells& sp = sdState.spells;
+  for (uint16_t k = 0; k < sp.pool.count; k++) {
+    uint16_t id = sp.pool.dense[k];
+    displayBlit(SPR_SPELL + sp.colorIdx[id], (int)sp.x[id], lerpPx(sp.prevY[id], sp.y[id], alpha));
+  }
+
+  int px = lerpPx(sdState.prevPlayerX, sdState.playerX, alpha);
+  int py = SCREEN_H - 20;
+  displayBlit(SPR_DODGER, px, py);
+
+  drawOverlays(alpha);
+  displayEndDraw();
+}
+
+static void swapGhostState() {
+  uint8_t* a = (uint8_t*)mgActive->state;
+  uint8_t* b = (uint8_t*)&ghost.state;
+  uint8_t tmp[64];
+  for (uint16_t off = 0; off < mgActive->stateSize; off += sizeof(tmp)) {
+    uint16_t n = mgActive->stateSize - off;
+    if (n > sizeof(tmp)) n = sizeof(tmp);
+    memcpy(tmp, a + off, n);
+    memcpy(a + off, b + off, n);
+    memcpy(b + off, tmp, n);
+  }
+}
+
+static void ghostStep() {
+  JoystickState js;
+  if (!mgPlayNext(ghost.player, js)) {
+    ghost.active = false;
+    return;
+  }
+  swapGhostState();
+  mgStep(*mgActive, ghost.ctx, js);
+  bool alive = mgActive->alive();
+  ghost.prevX = ghost.x;
+  ghost.prevY = ghost.y;
+  mgActive->player(ghost.x, ghost.y);
+  swapGhostState();
+  if (!alive) ghost.active = false;
+}
+
+MgRecording& mgGhostSlot() {
+  return ghost.rec;
+}
+
+static void soakSample() {
+  soak.heapFree = ESP.getFreeHeap();
+  soak.heapMin = ESP.getMinFreeHeap();
+  uint32_t stackFree = uxTaskGetStackHighWaterMark(nullptr);
+  if (soak.stackFreeMin == 0 || stackFree < soak.stackFreeMin) soak.stackFreeMin = stackFree;
+
+  uint32_t fps = soak.frameUsTotal ? (uint32_t)((uint64_t)soak.frames * 1000000 / soak.frameUsTotal) : 0;
+  snprintf(soakText, sizeof(soakText), "%s r%lu %lufps %lums e%u h%lu/%luk s%lu", stressMode ? "MAX" : "BOT", (unsigned long)soak.runs,
+           (unsigned long)fps, (unsigned long)(soak.frameUsMax / 1000), soak.entitiesMax,
+           (unsigned long)(soak.heapFree / 1024), (unsigned long)(soak.heapMin / 1024),
+           (unsigned long)soak.stackFreeMin);
+  soakDirty = true;
+}
+
+static void soakRestart() {
+  if (mgActive->score() > soak.bestScore) soak.bestScore = mgActive->score();
+  soak.runs++;
+  snakeDrawn.valid = false;
+  mgStart(*mgActive, mgCtx, prngNext(PRNG_MINIGAME));
+}
+
+// With MG_MODE_GHOST the live run uses the seed of the run in
+// mgGhostSlot() so both play the same world until their inputs diverge.
+// Soak runs are silent and never reported as finished runs, so bots
+// cannot replace a stored best run. Stress runs are soak runs whose
+// entity pools are topped up to capacity before every tick.
+void mgInit(AppState game, MgMode mode) {
+  mgActive = mgFind(game);
+  if (!mgActive) return;
+  uint8_t index = game - STATE_GAME_MANA_RUNNER;
+  snakeDrawn.valid = false;
+
+  ghost.active = mode == MG_MODE_GHOST && ghost.rec.game == index && ghost.rec.version == MG_REC_VERSION;
+  uint32_t seed = ghost.active ? ghost.rec.seed : prngNext(PRNG_MINIGAME);
+  if (ghost.active) {
+    mgPlayBegin(ghost.player, ghost.rec);
+    ghost.ctx.sound = nullptr;
+    swapGhostState();
+    mgStart(*mgActive, ghost.ctx, seed);
+    mgActive->player(ghost.x, ghost.y);
+    swapGhostState();
+    ghost.prevX = ghost.x;
+    ghost.prevY = ghost.y;
+  }
+
+  soakMode = mode == MG_MODE_SOAK || mode == MG_MODE_STRESS;
+  stressMode = mode == MG_MODE_STRESS && mgActive->fill;
+  if (soakMode) {
+    memset(&soak, 0, sizeof(soak));
+    soak.startMs = millis();
+    soakRefreshMs = soak.startMs;
+    soakSample();
+  }
+
+  mgCtx.sound = soakMode ? nullptr : mgPlaySound;
+  mgStart(*mgActive, mgCtx, seed);
+  mgRecBegin(recorder, liveRec, index, seed);
+  runReported = soakMode;
+  frameLastUs = micros();
+  frameAccumUs = 0;
+}
+
+// Reports the live run once, after it ends.
+bool mgFinishedRun(MgRunResult& run) {
+  if (runReported || !mgActive || mgActive->alive()) return false;
+  runReported = true;
+  run.game = liveRec.game;
+  run.score = mgActive->score();
+  run.ticks = mgCtx.tick;
+  run.seed = liveRec.seed;
+  run.rec = mgRecEnd(recorder, run.score) ? &liveRec : nullptr;
+  return true;
+}
+
+bool mgSoaking() {
+  return soakMode && mgActive;
+}
+
+const MgSoakStats& mgSoakStats() {
+  return soak;
+}
+
+// Runs as many whole logic ticks as real time allows, then renders once.
+// A long stall (flash write, face-down, debugger) is clamped to
+// MG_MAX_FRAME_US so the game skips ahead instead of fast-forwarding.
+void mgFrame(AppState game, const JoystickState& js) {
+  if (!mgActive || mgActive != mgFind(game)) return;
+
+  unsigned long nowUs = micros();
+  uint32_t elapsed = nowUs - frameLastUs;
+  frameLastUs = nowUs;
+  frameAccumUs += (elapsed > MG_MAX_FRAME_US) ? MG_MAX_FRAME_US : elapsed;
+
+  while (frameAccumUs >= MG_TICK_US) {
+    if (mgActive->alive()) {
+      if (soakMode) {
+        if (stressMode) mgActive->fill(mgCtx);
+        mgStep(*mgActive, mgCtx, mgBotInput(game - STATE_GAME_MANA_RUNNER));
+        if (mgActive->entities() > soak.entitiesMax) soak.entitiesMax = mgActive->entities();
+      } else {
+        mgRecPush(recorder, js);
+        mgStep(*mgActive, mgCtx, js);
+        if (ghost.active) ghostStep();
+      }
+    }
+    frameAccumUs -= MG_TICK_US;
+  }
+
+  if (soakMode) {
+    soak.frames++;
+    soak.frameUsTotal += elapsed;
+    if (elapsed > soak.frameUsMax) soak.frameUsMax = elapsed;
+    if (!mgActive->alive()) soakRestart();
+    if (millis() - soakRefreshMs >= SOAK_REFRESH_MS) {
+      soakRefreshMs = millis();
+      soakSample();
+    }
+  }
+  mgActive->render(mgCtx, (float)frameAccumUs / MG_TICK_US);
+}
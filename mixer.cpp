@@ -0,0 +1,195 @@
+#include "mixer.h"
+#include "satmath.h"
+#include "perf.h"
+#include <M5Unified.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+#define MIXER_BUFFERS 3
+
+struct MixerVoice {
+  MixerWave wave;
+  bool active;
+  uint8_t volume;
+  uint32_t phase;
+  uint32_t phaseInc;
+  int32_t phaseIncStep;
+  uint32_t remaining;
+  uint32_t total;
+  const int8_t* pcm;
+  uint32_t pcmEnd;
+};
+
+struct MixerRequest {
+  bool stop;
+  MixerSound sound;
+};
+
+static MixerVoice voices[MIXER_VOICES];
+static int16_t buffers[MIXER_BUFFERS][MIXER_BLOCK];
+static QueueHandle_t mixerQueue = nullptr;
+static volatile MixerStats stats;
+static uint16_t noiseLfsr = 0xACE1;
+
+static uint32_t phaseIncFor(uint32_t freq, uint32_t rate) {
+  return (uint32_t)(((uint64_t)freq << 32) / rate);
+}
+
+static void startVoice(const MixerSound& s) {
+  MixerVoice* v = &voices[0];
+  for (uint8_t i = 0; i < MIXER_VOICES; i++) {
+    if (!voices[i].active) { v = &voices[i]; break; }
+    if (voices[i].remaining < v->remaining) v = &voices[i];
+  }
+
+  v->wave = s.wave;
+  v->volume = s.volume;
+  v->phase = 0;
+  if (s.wave == WAVE_PCM) {
+    v->phaseInc = phaseIncFor(s.pcmRate, MIXER_SAMPLE_RATE) >> 16;
+    v->pcm = s.pcm;
+    v->pcmEnd = (uint32_t)s.pcmLen << 16;
+    v->total = (uint32_t)s.pcmLen * MIXER_SAMPLE_RATE / s.pcmRate;
+    v->phaseIncStep = 0;
+  } else {
+    v->total = (uint32_t)s.durationMs * MIXER_SAMPLE_RATE / 1000;
+    v->phaseInc = phaseIncFor(s.freq, MIXER_SAMPLE_RATE);
+    uint32_t endInc = phaseIncFor(s.freqEnd ? s.freqEnd : s.freq, MIXER_SAMPLE_RATE);
+    int32_t blocks = v->total / MIXER_BLOCK;
+    v->phaseIncStep = blocks ? ((int32_t)endInc - (int32_t)v->phaseInc) / blocks : 0;
+  }
+  v->remaining = v->total;
+  v->active = v->total > 0;
+}
+
+// Each voice is rendered with its own tight loop so the waveform switch
+// runs once per block, not once per sample. The gain is a linear decay
+// stepped per block, which is enough to avoid clicks at the tail.
+static void renderVoice(MixerVoice& v, int32_t* acc) {
+  uint32_t n = v.remaining < MIXER_BLOCK ? v.remaining : MIXER_BLOCK;
+  int32_t gain = (int32_t)v.volume * (int32_t)(v.remaining >> 4) / (int32_t)((v.total >> 4) | 1);
+  uint32_t phase = v.phase;
+  uint32_t inc = v.phaseInc;
+
+  switch (v.wave) {
+    case WAVE_SQUARE:
+      for (uint32_t i = 0; i < n; i++) {
+        acc[i] += (phase & 0x80000000u) ? gain * 32 : -gain * 32;
+        phase += inc;
+      }
+      break;
+    case WAVE_TRIANGLE:
+      for (uint32_t i = 0; i < n; i++) {
+        int32_t u = phase >> 16;
+        int32_t tri = (u < 32768) ? u - 16384 : 49151 - u;
+        acc[i] += (tri * gain) >> 9;
+        phase += inc;
+      }
+      break;
+    case WAVE_NOISE:
+      for (uint32_t i = 0; i < n; i++) {
+        noiseLfsr = (noiseLfsr >> 1) ^ (-(noiseLfsr & 1) & 0xB400);
+        acc[i] += ((int32_t)(noiseLfsr & 0xFF) - 128) * gain / 4;
+      }
+      break;
+    case WAVE_PCM:
+      for (uint32_t i = 0; i < n && phase < v.pcmEnd; i++) {
+        acc[i] += (int32_t)(int8_t)pgm_read_byte(&v.pcm[phase >> 16]) * gain / 4;
+        phase += inc;
+      }
+      if (phase >= v.pcmEnd) n = v.remaining;
+      break;
+  }
+
+  v.phase = phase;
+  v.phaseInc = inc + v.phaseIncStep;
+  v.remaining -= n;
+  if (v.remaining == 0) v.active = false;
+}
+
+static uint8_t renderBlock(int16_t* out) {
+  int32_t acc[MIXER_BLOCK];
+  memset(acc, 0, sizeof(acc));
+
+  uint8_t active = 0;
+  for (uint8_t i = 0; i < MIXER_VOICES; i++) {
+    if (!voices[i].active) continue;
+    renderVoice(voices[i], acc);
+    active++;
+  }
+  for (uint16_t i = 0; i < MIXER_BLOCK; i++) {
+    out[i] = satClamp<int16_t>(acc[i], INT16_MIN, INT16_MAX);
+  }
+  return active;
+}
+
+static bool anyActive() {
+  for (uint8_t i = 0; i < MIXER_VOICES; i++) {
+    if (voices[i].active) return true;
+  }
+  return false;
+}
+
+static void applyRequest(const MixerRequest& req) {
+  if (req.stop) {
+    for (uint8_t i = 0; i < MIXER_VOICES; i++) voices[i].active = false;
+  } else {
+    startVoice(req.sound);
+  }
+}
+
+static void mixerTask(void*) {
+  uint8_t bufIdx = 0;
+  MixerRequest req;
+
+  for (;;) {
+    TickType_t wait = anyActive() ? 0 : portMAX_DELAY;
+    while (xQueueReceive(mixerQueue, &req, wait) == pdTRUE) {
+      applyRequest(req);
+      wait = 0;
+    }
+    if (!anyActive()) continue;
+
+    unsigned long t0 = micros();
+    stats.activeVoices = renderBlock(buffers[bufIdx]);
+    uint16_t us = micros() - t0;
+    stats.lastUs = us;
+    if (us > stats.maxUs) stats.maxUs = us;
+    stats.blocks++;
+
+    // The speaker holds two queued buffers per channel and this call waits
+    // for a free slot, which paces the task to the output rate. A third
+    // buffer keeps the one being rendered apart from both queued ones.
+    M5.Speaker.playRaw(buffers[bufIdx], MIXER_BLOCK, MIXER_SAMPLE_RATE, false, 1, MIXER_CHANNEL, false);
+    bufIdx = (bufIdx + 1) % MIXER_BUFFERS;
+  }
+}
+
+void mixerInit() {
+  mixerQueue = xQueueCreate(MIXER_QUEUE_LEN, sizeof(MixerRequest));
+  TaskHandle_t task = nullptr;
+  xTaskCreate(mixerTask, "mixer", MIXER_TASK_STACK, nullptr, AUDIO_TASK_PRIORITY, &task);
+  perfWatchTask(task, "mixer");
+}
+
+void mixerPlay(const MixerSound& sound) {
+  if (!mixerQueue) return;
+  MixerRequest req = { false, sound };
+  xQueueSend(mixerQueue, &req, 0);
+}
+
+void mixerStopAll() {
+  if (!mixerQueue) return;
+  MixerRequest req = {};
+  req.stop = true;
+  xQueueSend(mixerQueue, &req, 0);
+}
+
+MixerStats mixerGetStats() {
+  MixerStats s;
+  s.blocks = stats.blocks;
+  s.lastUs = stats.lastUs;
+  s.maxUs = stats.maxUs;
+  s.activeVoices = stats.activeVoices;
+  return s;
+}
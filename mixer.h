@@ -0,0 +1,40 @@
+#ifndef MIXER_H
+#define MIXER_H
+
+#include "config.h"
+
+// Small software mixer for minigame effects. Up to MIXER_VOICES sounds
+// overlap; a background task renders MIXER_BLOCK samples at a time and
+// hands them to the speaker on MIXER_CHANNEL, separate from the tone
+// channel the sequencer uses.
+enum MixerWave : uint8_t {
+  WAVE_SQUARE,
+  WAVE_TRIANGLE,
+  WAVE_NOISE,
+  WAVE_PCM
+};
+
+struct MixerSound {
+  MixerWave wave;
+  uint8_t volume;
+  uint16_t freq;
+  uint16_t freqEnd;
+  uint16_t durationMs;
+  const int8_t* pcm;
+  uint16_t pcmLen;
+  uint16_t pcmRate;
+};
+
+struct MixerStats {
+  uint32_t blocks;
+  uint16_t lastUs;
+  uint16_t maxUs;
+  uint8_t activeVoices;
+};
+
+void mixerInit();
+void mixerPlay(const MixerSound& sound);
+void mixerStopAll();
+MixerStats mixerGetStats();
+
+#endif
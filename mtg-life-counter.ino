@@ -8,7 +8,16 @@
 #include "display.h"
 #include "audio.h"
 #include "joystick.h"
+#include "tilt.h"
+#include "perf.h"
+#include "benchmark.h"
+#include "telemetry.h"
+#include "console.h"
 #include "minigames.h"
+#include "mgboard.h"
+#include "satmath.h"
+#include "prng.h"
+#include "turntimer.h"
 
 Preferences prefs;
 
@@ -25,14 +34,18 @@ unsigned long lastPowerCheckMs = 0;
 
 bool isFaceDown = false;
 unsigned long lastOrientationCheckMs = 0;
-unsigned long faceDownStartMs = 0;
-unsigned long pausedTimeMs = 0;
+
+unsigned long lastTelemetryMs = 0;
+uint8_t telemetryChannel = TELE_BATT_MV;
+AppState telemetryReturn = STATE_BATTERY_INFO;
 
 uint8_t settingBrightness = DEFAULT_BRIGHTNESS;
 uint8_t settingVolume = SPEAKER_VOLUME;
 TimerMode settingTimerMode = TIMER_PER_TURN;
 ThemeId settingTheme = THEME_PLAINS;
 bool settingFaceDownPause = true;
+bool settingPerfHud = false;
+uint8_t settingTelemetryRateIdx = TELEMETRY_RATE_DEFAULT;
 uint8_t settingShutdownIdleIdx = 0;
 uint8_t settingShutdownGameIdx = 0;
 uint8_t settingsSelection = 0;
@@ -41,21 +54,42 @@ uint8_t mainMenuSel = 0;
 uint8_t gameModeSel = 0;
 uint8_t diagnosticsSel = 0;
 
-uint8_t customLifeInput = LIFE_DEFAULT;
+int16_t customLifeInput = LIFE_DEFAULT;
+uint8_t counterSel = 0;
+
+int8_t quickEntrySign = -1;
+uint8_t quickEntryDigits[QUICK_ENTRY_DIGITS] = { 0 };
+
+uint8_t quickEntryField = 0;
+
+bool resultAnimActive = false;
+uint8_t resultAnimFrame = 0;
+unsigned long resultAnimNextMs = 0;
+GameState replayState;
+uint16_t replayPos = 0;
+
+uint8_t playerCountInput = MIN_PLAYERS;
 
 uint8_t themeSelectPlayerIndex = 0;
-ThemeId themeSelectChoice[MAX_PLAYERS] = { THEME_PLAINS, THEME_ISLAND };
+ThemeId themeSelectChoice[MAX_PLAYERS] = { THEME_PLAINS, THEME_ISLAND, THEME_SWAMP, THEME_MOUNTAIN, THEME_FOREST, THEME_PLAINS };
 
 uint16_t statTotalMatches = 0;
 uint32_t statTotalPlaytimeSeconds = 0;
-uint16_t statPlayer1Wins = 0;
-uint16_t statPlayer2Wins = 0;
+uint16_t statPlayerWins[MAX_PLAYERS] = { 0 };
 uint16_t statDiceRolls = 0;
 uint16_t statCoinFlips = 0;
 
 bool joystickConnected = false;
 JoystickState joystickState;
 uint8_t easterEggsSel = 0;
+MgMode easterEggsMode = MG_MODE_PLAY;
+const char* const EE_MODE_NAMES[] = { "Play", "Ghost", "Soak", "Stress" };
+
+MgLeaderboard mgBoard;
+MgScoreEntry pendingScore;
+uint8_t pendingGame = 0;
+uint8_t initialsPos = 0;
+uint8_t scoresGame = 0;
 
 bool diagHasEasterEggs = false;
 
@@ -72,6 +106,7 @@ void resetActivity() {
 void imuSleep() {
   if (!imuAsleep) {
     M5.In_I2C.writeRegister8(0x68, 0x6B, 0x40, 100000);
+    perfCountI2C();
     imuAsleep = true;
   }
 }
@@ -79,13 +114,37 @@ void imuSleep() {
 void imuWake() {
   if (imuAsleep) {
     M5.In_I2C.writeRegister8(0x68, 0x6B, 0x00, 100000);
-    delay(10);
+    perfCountI2C();
+    perfDelay(10);
     imuAsleep = false;
   }
 }
 
 bool imuShouldBeAwake(AppState state) {
-  return (state == STATE_GAME || state == STATE_DICE || state == STATE_COIN || state == STATE_IMU_STATUS || state == STATE_IMU_CALIBRATION);
+  if (tiltActive()) return true;
+  return (state == STATE_GAME || state == STATE_DICE || state == STATE_COIN || state == STATE_IMU_STATUS || state == STATE_IMU_CALIBRATION || state == STATE_BENCHMARK);
+}
+
+uint16_t telemetryIntervalS() {
+  return pgm_read_word(&TELEMETRY_RATE_S[settingTelemetryRateIdx]);
+}
+
+void sampleTelemetry() {
+  int16_t v[TELE_CHANNELS];
+  v[TELE_BATT_MV] = M5.Power.getBatteryVoltage();
+  v[TELE_BATT_PCT] = M5.Power.getBatteryLevel();
+  v[TELE_TEMP_DC] = (int16_t)lroundf(temperatureRead() * 10);
+  v[TELE_HEAP] = ESP.getFreeHeap() / TELEMETRY_HEAP_UNIT;
+  v[TELE_CPU_MHZ] = getCpuFrequencyMhz();
+  telemetryAppend(v, telemetryIntervalS());
+  lastTelemetryMs = millis();
+}
+
+void showTelemetry(uint8_t channel) {
+  telemetryReturn = gameState.appState;
+  telemetryChannel = channel;
+  gameState.appState = STATE_TELEMETRY;
+  displayTelemetry(telemetryChannel, telemetryIntervalS(), true);
 }
 
 void checkPowerSaving() {
@@ -109,23 +168,18 @@ void checkFaceDown() {
 
   float accX, accY, accZ;
   M5.Imu.getAccelData(&accX, &accY, &accZ);
+  perfCountI2C();
 
   bool nowFaceDown = (accZ < FACE_DOWN_THRESHOLD);
 
   if (nowFaceDown && !isFaceDown) {
     isFaceDown = true;
-    faceDownStartMs = millis();
+    turnTimerPause();
     M5.Display.setBrightness(0);
     M5.Display.sleep();
   } else if (!nowFaceDown && isFaceDown) {
     isFaceDown = false;
-    unsigned long pauseDuration = millis() - faceDownStartMs;
-    pausedTimeMs += pauseDuration;
-
-    if (gameState.timerRunning) {
-      gameState.turnStartMs += pauseDuration;
-      gameState.matchStartMs += pauseDuration;
-    }
+    turnTimerResume();
 
     M5.Display.wakeup();
     if (powerSavingActive) {
@@ -133,6 +187,7 @@ void checkFaceDown() {
     } else {
       M5.Display.setBrightness(settingBrightness);
     }
+    displayInvalidate();
     displayGame(gameState, settingTimerMode);
   }
 }
@@ -142,18 +197,30 @@ void loadConfig() {
   settingBrightness = prefs.getUChar("brightness", DEFAULT_BRIGHTNESS);
   settingVolume = prefs.getUChar("volume", SPEAKER_VOLUME);
   settingTimerMode = (TimerMode)prefs.getUChar("timerMode", TIMER_PER_TURN);
+  if (settingTimerMode >= TIMER_MODE_COUNT) settingTimerMode = TIMER_PER_TURN;
   settingTheme = (ThemeId)prefs.getUChar("theme", THEME_PLAINS);
   settingFaceDownPause = prefs.getBool("faceDownPause", true);
+  settingPerfHud = prefs.getBool("perfHud", false);
+  settingTelemetryRateIdx = prefs.getUChar("teleRate", TELEMETRY_RATE_DEFAULT);
+  if (settingTelemetryRateIdx >= TELEMETRY_RATE_COUNT) settingTelemetryRateIdx = TELEMETRY_RATE_DEFAULT;
   settingShutdownIdleIdx = prefs.getUChar("shutIdleIdx", 0);
   settingShutdownGameIdx = prefs.getUChar("shutGameIdx", 0);
+  playerCountInput = prefs.getUChar("playerCount", MIN_PLAYERS);
+  if (playerCountInput < MIN_PLAYERS || playerCountInput > MAX_PLAYERS) playerCountInput = MIN_PLAYERS;
 
   statTotalMatches = prefs.getUShort("totalMatches", 0);
   statTotalPlaytimeSeconds = prefs.getUInt("totalPlaytime", 0);
-  statPlayer1Wins = prefs.getUShort("p1wins", 0);
-  statPlayer2Wins = prefs.getUShort("p2wins", 0);
+  char key[8];
+  for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+    snprintf(key, sizeof(key), "p%dwins", i + 1);
+    statPlayerWins[i] = prefs.getUShort(key, 0);
+  }
   statDiceRolls = prefs.getUShort("diceRolls", 0);
   statCoinFlips = prefs.getUShort("coinFlips", 0);
 
+  size_t boardLen = prefs.isKey("mgboard") ? prefs.getBytes("mgboard", &mgBoard, sizeof(mgBoard)) : 0;
+  if (!mgBoardValid(mgBoard, boardLen)) mgBoardReset(mgBoard);
+
   prefs.end();
 }
 
@@ -164,8 +231,11 @@ void saveConfig() {
   prefs.putUChar("timerMode", (uint8_t)settingTimerMode);
   prefs.putUChar("theme", (uint8_t)settingTheme);
   prefs.putBool("faceDownPause", settingFaceDownPause);
+  prefs.putBool("perfHud", settingPerfHud);
+  prefs.putUChar("teleRate", settingTelemetryRateIdx);
   prefs.putUChar("shutIdleIdx", settingShutdownIdleIdx);
   prefs.putUChar("shutGameIdx", settingShutdownGameIdx);
+  prefs.putUChar("playerCount", playerCountInput);
   prefs.end();
 }
 
@@ -173,8 +243,11 @@ void saveStats() {
   prefs.begin("mtg-config", false);
   prefs.putUShort("totalMatches", statTotalMatches);
   prefs.putUInt("totalPlaytime", statTotalPlaytimeSeconds);
-  prefs.putUShort("p1wins", statPlayer1Wins);
-  prefs.putUShort("p2wins", statPlayer2Wins);
+  char key[8];
+  for (uint8_t i = 0; i < MAX_PLAYERS; i++) {
+    snprintf(key, sizeof(key), "p%dwins", i + 1);
+    prefs.putUShort(key, statPlayerWins[i]);
+  }
   prefs.putUShort("diceRolls", statDiceRolls);
   prefs.putUShort("coinFlips", statCoinFlips);
   prefs.end();
@@ -183,8 +256,7 @@ void saveStats() {
 void resetStats() {
   statTotalMatches = 0;
   statTotalPlaytimeSeconds = 0;
-  statPlayer1Wins = 0;
-  statPlayer2Wins = 0;
+  memset(statPlayerWins, 0, sizeof(statPlayerWins));
   statDiceRolls = 0;
   statCoinFlips = 0;
 
@@ -238,9 +310,8 @@ void handleGameModeSelect(InputEvent evt) {
           displayCustomLifeInput(customLifeInput);
         } else {
           customLifeInput = (gameModeSel == GMODE_STANDARD) ? LIFE_STANDARD : LIFE_COMMANDER;
-          gameState.appState = STATE_PLAYER_THEME_SELECT;
-          themeSelectPlayerIndex = 0;
-          displayPlayerThemeSelect(themeSelectPlayerIndex, themeSelectChoice[themeSelectPlayerIndex]);
+          gameState.appState = STATE_PLAYER_COUNT_SELECT;
+          displayPlayerCountSelect(playerCountInput);
         }
         break;
       }
@@ -271,22 +342,46 @@ void handleCustomLifeInput(InputEvent evt) {
       break;
 
     case INPUT_A_LONG:
-      customLifeInput = (customLifeInput + 5 > LIFE_MAX) ? LIFE_MAX : customLifeInput + 5;
+      customLifeInput = satAdd<int16_t>(customLifeInput, 5, LIFE_MIN, LIFE_MAX);
       displayCustomLifeInput(customLifeInput);
       break;
 
     case INPUT_B_LONG:
-      customLifeInput = (customLifeInput - 5 < LIFE_MIN) ? LIFE_MIN : customLifeInput - 5;
+      customLifeInput = satSub<int16_t>(customLifeInput, 5, LIFE_MIN, LIFE_MAX);
       displayCustomLifeInput(customLifeInput);
       break;
 
     case INPUT_PWR:
       audioConfirm();
+      gameState.appState = STATE_PLAYER_COUNT_SELECT;
+      displayPlayerCountSelect(playerCountInput);
+      break;
+
+    default:
+      break;
+  }
+}
+
+void handlePlayerCountSelect(InputEvent evt) {
+  switch (evt) {
+    case INPUT_B_PRESS:
+      playerCountInput = (playerCountInput >= MAX_PLAYERS) ? MIN_PLAYERS : playerCountInput + 1;
+      displayPlayerCountSelect(playerCountInput);
+      break;
+
+    case INPUT_A_PRESS:
+      audioConfirm();
+      saveConfig();
       gameState.appState = STATE_PLAYER_THEME_SELECT;
       themeSelectPlayerIndex = 0;
       displayPlayerThemeSelect(themeSelectPlayerIndex, themeSelectChoice[themeSelectPlayerIndex]);
       break;
 
+    case INPUT_PWR:
+      gameState.appState = STATE_GAME_MODE_SELECT;
+      displayGameModeSelect(gameModeSel);
+      break;
+
     default:
       break;
   }
@@ -301,13 +396,11 @@ void handlePlayerThemeSelect(InputEvent evt) {
 
     case INPUT_A_PRESS:
       audioConfirm();
-      if (themeSelectPlayerIndex == 0) {
-        themeSelectPlayerIndex = 1;
+      if (themeSelectPlayerIndex + 1 < playerCountInput) {
+        themeSelectPlayerIndex++;
         displayPlayerThemeSelect(themeSelectPlayerIndex, themeSelectChoice[themeSelectPlayerIndex]);
       } else {
-        gameInit(gameState, customLifeInput);
-        gameState.players[0].theme = themeSelectChoice[0];
-        gameState.players[1].theme = themeSelectChoice[1];
+        gameInit(gameState, customLifeInput, playerCountInput, themeSelectChoice);
         displayGame(gameState, settingTimerMode);
       }
       break;
@@ -333,6 +426,20 @@ void handleGameMenu(InputEvent evt) {
             gameState.appState = STATE_GAME;
             displayGame(gameState, settingTimerMode);
             break;
+          case GMENU_COUNTERS:
+            inGameMenu = false;
+            gameState.appState = STATE_COUNTERS;
+            counterSel = 0;
+            displayCounters(gameState, counterSel);
+            break;
+          case GMENU_QUICK_ENTRY:
+            inGameMenu = false;
+            gameState.appState = STATE_QUICK_ENTRY;
+            quickEntrySign = -1;
+            memset(quickEntryDigits, 0, sizeof(quickEntryDigits));
+            quickEntryField = 1;
+            redrawQuickEntry();
+            break;
           case GMENU_DICE:
             inGameMenu = false;
             gameState.appState = STATE_DICE;
@@ -345,6 +452,11 @@ void handleGameMenu(InputEvent evt) {
             gameState.showingResult = false;
             displayCoin(gameState);
             break;
+          case GMENU_TURN_STATS:
+            inGameMenu = false;
+            gameState.appState = STATE_TURN_STATS;
+            displayTurnStats(gameState);
+            break;
           case GMENU_SETTINGS:
             inGameMenu = false;
             gameState.appState = STATE_SETTINGS;
@@ -372,26 +484,184 @@ void handleGameMenu(InputEvent evt) {
   }
 }
 
-void applyLifeChange(int8_t delta) {
-  gameAddLife(gameState, gameState.activePlayer, delta);
-  if (delta > 0) audioLifeUp(); else audioLifeDown();
+bool settleGameChange(uint8_t aliveBefore) {
   if (gameState.gameOver) {
     statTotalMatches++;
     statTotalPlaytimeSeconds += gameGetMatchSeconds(gameState);
-    uint8_t winner = (gameState.loserIndex == 0) ? 1 : 0;
-    if (winner == 0) statPlayer1Wins++; else statPlayer2Wins++;
+    uint8_t winner = gameState.winnerIndex;
+    statPlayerWins[winner]++;
     saveStats();
+    gameState.appState = STATE_GAME;
+    audioVictory(gameState.players.theme[winner]);
     displayVictoryAnimation(winner, gameState);
-    audioVictory();
     displayGameOver(gameState, settingTimerMode);
+    return true;
+  }
+  if (gameState.aliveMask != aliveBefore) audioDefeat();
+  return false;
+}
+
+void applyLifeChange(int16_t delta) {
+  uint8_t aliveBefore = gameState.aliveMask;
+  gameAddLife(gameState, gameState.activePlayer, delta);
+  if (delta > 0) audioLifeUp(); else audioLifeDown();
+  if (!settleGameChange(aliveBefore)) {
+    displayGame(gameState, settingTimerMode);
+  }
+}
+
+void applyCounterChange(int8_t delta) {
+  uint8_t player = gameState.activePlayer;
+  uint8_t aliveBefore = gameState.aliveMask;
+  gameAddCounter(gameState, player, counterSel, delta);
+  if (delta > 0) audioLifeUp(); else audioLifeDown();
+  if (settleGameChange(aliveBefore)) return;
+
+  if (gameState.activePlayer != player) {
+    gameState.appState = STATE_GAME;
+    displayGame(gameState, settingTimerMode);
   } else {
+    displayCounters(gameState, counterSel);
+  }
+}
+
+void redrawQuickEntry() {
+  displayQuickEntry(gameState, quickEntrySign, quickEntryDigits, quickEntryField);
+}
+
+void handleQuickEntry(InputEvent evt) {
+  switch (evt) {
+    case INPUT_A_PRESS:
+      if (quickEntryField == 0) {
+        quickEntrySign = -quickEntrySign;
+      } else if (quickEntryField <= QUICK_ENTRY_DIGITS) {
+        uint8_t& d = quickEntryDigits[quickEntryField - 1];
+        d = (d + 1) % 10;
+      } else {
+        int16_t amount = 0;
+        for (uint8_t i = 0; i < QUICK_ENTRY_DIGITS; i++) {
+          amount = amount * 10 + quickEntryDigits[i];
+        }
+        gameState.appState = STATE_GAME;
+        if (amount > 0) {
+          applyLifeChange(quickEntrySign * amount);
+        } else {
+          displayGame(gameState, settingTimerMode);
+        }
+        break;
+      }
+      redrawQuickEntry();
+      break;
+    case INPUT_B_PRESS:
+      quickEntryField = (quickEntryField + 1) % (QUICK_ENTRY_DIGITS + 2);
+      redrawQuickEntry();
+      break;
+    case INPUT_PWR:
+      gameState.appState = STATE_GAME;
+      displayGame(gameState, settingTimerMode);
+      break;
+    default:
+      break;
+  }
+}
+
+// counterSel runs over the counter slots and then one past them, the
+// "Done" row that returns to the game.
+uint8_t counterDoneSel() {
+  return COUNTER_CMDR_BASE + gameState.playerCount;
+}
+
+void stepCounterSel() {
+  do {
+    counterSel = (counterSel + 1) % (counterDoneSel() + 1);
+  } while (counterSel == COUNTER_CMDR_BASE + gameState.activePlayer);
+  displayCounters(gameState, counterSel);
+}
+
+void handleCounters(InputEvent evt) {
+  if (counterSel == counterDoneSel()) {
+    if (evt == INPUT_A_PRESS || evt == INPUT_B_PRESS) {
+      gameState.appState = STATE_GAME;
+      displayGame(gameState, settingTimerMode);
+    } else if (evt == INPUT_PWR) {
+      stepCounterSel();
+    }
+    return;
+  }
+
+  switch (evt) {
+    case INPUT_A_PRESS:
+    case INPUT_A_LONG:  applyCounterChange(1);  break;
+    case INPUT_B_PRESS:
+    case INPUT_B_LONG:  applyCounterChange(-1); break;
+    case INPUT_PWR:     stepCounterSel();       break;
+    default:
+      break;
+  }
+}
+
+void showReplay() {
+  gameReplay(replayState, replayPos);
+  const MatchEvent* events = gameEvents();
+  unsigned long elapsedDs = 0;
+  for (uint16_t i = 0; i < replayPos; i++) {
+    elapsedDs += events[i].dtDs;
+  }
+  displayReplay(replayState, replayPos, gameEventCount(),
+                replayPos > 0 ? &events[replayPos - 1] : nullptr, elapsedDs);
+}
+
+void stepReplay(int16_t delta) {
+  int32_t pos = (int32_t)replayPos + delta;
+  if (pos < 0) pos = 0;
+  if (pos > gameEventCount()) pos = gameEventCount();
+  replayPos = pos;
+  showReplay();
+}
+
+void handleMatchReplay(InputEvent evt) {
+  switch (evt) {
+    case INPUT_A_PRESS: stepReplay(1);   break;
+    case INPUT_B_PRESS: stepReplay(-1);  break;
+    case INPUT_A_LONG:  stepReplay(10);  break;
+    case INPUT_B_LONG:  stepReplay(-10); break;
+
+    case INPUT_PWR:
+      gameState.appState = STATE_GAME;
+      displayGameOver(gameState, settingTimerMode);
+      break;
+    default:
+      break;
+  }
+}
+
+void handleTurnStats(InputEvent evt) {
+  if (evt == INPUT_PWR) {
+    gameState.appState = STATE_GAME;
+    displayGame(gameState, settingTimerMode);
+  }
+}
+
+void checkChessClock() {
+  if (settingTimerMode != TIMER_CHESS_CLOCK || !gameState.timerRunning || gameState.gameOver) return;
+
+  uint8_t player = gameState.activePlayer;
+  if (gameBankRemainingMs(gameState, player) > 0) return;
+
+  uint8_t aliveBefore = gameState.aliveMask;
+  gameFlagFall(gameState, player);
+  if (!settleGameChange(aliveBefore)) {
     displayGame(gameState, settingTimerMode);
   }
 }
 
 void handleGame(InputEvent evt) {
   if (gameState.gameOver) {
-    if (evt == INPUT_A_PRESS) {
+    if (evt == INPUT_B_PRESS) {
+      gameState.appState = STATE_MATCH_REPLAY;
+      replayPos = 0;
+      showReplay();
+    } else if (evt == INPUT_A_PRESS) {
       gameState.appState = STATE_GAME_MODE_SELECT;
       gameModeSel = 0;
       displayGameModeSelect(gameModeSel);
@@ -426,6 +696,38 @@ void handleGame(InputEvent evt) {
   }
 }
 
+void startResultAnimation() {
+  resultAnimActive = true;
+  resultAnimFrame = 0;
+  resultAnimNextMs = millis();
+}
+
+void updateResultAnimation() {
+  if (!resultAnimActive) return;
+  bool dice = (gameState.appState == STATE_DICE);
+  if (!dice && gameState.appState != STATE_COIN) {
+    resultAnimActive = false;
+    return;
+  }
+  if ((long)(millis() - resultAnimNextMs) < 0) return;
+
+  uint8_t frames = dice ? DICE_ANIM_FRAMES : COIN_ANIM_FRAMES;
+  if (resultAnimFrame >= frames) {
+    resultAnimActive = false;
+    if (dice) displayDice(gameState); else displayCoin(gameState);
+    return;
+  }
+
+  if (dice) {
+    displayDiceAnimationFrame(gameState.diceType);
+    resultAnimNextMs += 50 + resultAnimFrame * 15;
+  } else {
+    displayCoinAnimationFrame(resultAnimFrame);
+    resultAnimNextMs += 80 + resultAnimFrame * 20;
+  }
+  resultAnimFrame++;
+}
+
 void handleDice(InputEvent evt) {
   switch (evt) {
     case INPUT_A_PRESS:
@@ -443,19 +745,20 @@ void handleDice(InputEvent evt) {
 
         gameState.diceType = diceOptions[(currentIdx + 1) % optionCount];
         gameState.showingResult = false;
+        resultAnimActive = false;
         displayDice(gameState);
         break;
       }
     case INPUT_B_PRESS:
     case INPUT_SHAKE:
-      displayDiceAnimation(gameState.diceType);
       audioDiceRoll();
       gameRollDice(gameState, gameState.diceType);
       statDiceRolls++;
       saveStats();
-      displayDice(gameState);
+      startResultAnimation();
       break;
     case INPUT_PWR:
+      resultAnimActive = false;
       gameState.appState = STATE_GAME;
       gameState.showingResult = false;
       displayGame(gameState, settingTimerMode);
@@ -469,14 +772,14 @@ void handleCoin(InputEvent evt) {
   switch (evt) {
     case INPUT_B_PRESS:
     case INPUT_SHAKE:
-      displayCoinAnimation();
       audioCoinFlip();
       gameFlipCoin(gameState);
       statCoinFlips++;
       saveStats();
-      displayCoin(gameState);
+      startResultAnimation();
       break;
     case INPUT_PWR:
+      resultAnimActive = false;
       gameState.appState = STATE_GAME;
       gameState.showingResult = false;
       displayGame(gameState, settingTimerMode);
@@ -492,6 +795,10 @@ void redrawSettings() {
                   settingShutdownIdleIdx, settingShutdownGameIdx);
 }
 
+void redrawPerf() {
+  displayPerf(perfGetStats(), tiltGetStats(), settingPerfHud);
+}
+
 void redrawDiagnostics() {
   displayDiagnostics(diagnosticsSel, diagHasEasterEggs);
 }
@@ -523,6 +830,11 @@ void handleSettings(InputEvent evt) {
         saveConfig();
         audioConfirm();
         redrawSettings();
+      } else if (settingsSelection == SET_TIMER_MODE) {
+        settingTimerMode = (TimerMode)((settingTimerMode + 1) % TIMER_MODE_COUNT);
+        saveConfig();
+        audioConfirm();
+        redrawSettings();
       } else if (settingsSelection == SET_FACE_DOWN_PAUSE) {
         settingFaceDownPause = !settingFaceDownPause;
         saveConfig();
@@ -610,7 +922,8 @@ void detectEasterEggsHAT() {
   joystickConnected = false;
   joystickInit();
   joystickConnected = joystickDetect();
-  diagHasEasterEggs = joystickConnected;
+  // Without the HAT the minigames are steered by tilting the stick.
+  diagHasEasterEggs = joystickConnected || M5.Imu.isEnabled();
 }
 
 void handleDiagnostics(InputEvent evt) {
@@ -633,10 +946,14 @@ void handleDiagnostics(InputEvent evt) {
           gameState.appState = STATE_SYSTEM_INFO;
           displaySystemInfo();
           break;
+        case DIAG_PERF:
+          gameState.appState = STATE_PERF;
+          redrawPerf();
+          break;
         case DIAG_STATS:
           gameState.appState = STATE_GAME_STATS;
           displayGameStats(statTotalMatches, statTotalPlaytimeSeconds,
-                           statPlayer1Wins, statPlayer2Wins,
+                           statPlayerWins,
                            statDiceRolls, statCoinFlips);
           break;
         case DIAG_TEMPERATURE:
@@ -653,10 +970,10 @@ void handleDiagnostics(InputEvent evt) {
           displayTestMenu(testMenuSel);
           break;
         case DIAG_EASTER_EGGS:
-          if (joystickConnected) {
+          if (diagHasEasterEggs) {
             gameState.appState = STATE_EASTER_EGGS_MENU;
             easterEggsSel = 0;
-            displayEasterEggsMenu(easterEggsSel);
+            redrawEasterEggsMenu();
           }
           break;
         case DIAG_BACK:
@@ -675,25 +992,63 @@ void handleDiagnostics(InputEvent evt) {
 }
 
 void handleBatteryInfo(InputEvent evt) {
-  if (evt == INPUT_PWR || evt == INPUT_A_PRESS || evt == INPUT_B_PRESS) {
+  if (evt == INPUT_A_PRESS) {
+    showTelemetry(TELE_BATT_MV);
+  } else if (evt == INPUT_PWR || evt == INPUT_B_PRESS) {
     gameState.appState = STATE_DIAGNOSTICS;
     redrawDiagnostics();
   }
 }
 
 void handleSystemInfo(InputEvent evt) {
-  if (evt == INPUT_PWR || evt == INPUT_A_PRESS || evt == INPUT_B_PRESS) {
+  if (evt == INPUT_A_PRESS) {
+    showTelemetry(TELE_HEAP);
+  } else if (evt == INPUT_PWR || evt == INPUT_B_PRESS) {
+    gameState.appState = STATE_DIAGNOSTICS;
+    redrawDiagnostics();
+  }
+}
+
+void handlePerf(InputEvent evt) {
+  if (evt == INPUT_A_PRESS) {
+    settingPerfHud = !settingPerfHud;
+    displaySetPerfOverlay(settingPerfHud);
+    saveConfig();
+    redrawPerf();
+  } else if (evt == INPUT_PWR || evt == INPUT_B_PRESS) {
     gameState.appState = STATE_DIAGNOSTICS;
     redrawDiagnostics();
   }
 }
 
+void handleTelemetry(InputEvent evt) {
+  switch (evt) {
+    case INPUT_A_PRESS:
+      telemetryChannel = (telemetryChannel + 1) % TELE_CHANNELS;
+      displayTelemetry(telemetryChannel, telemetryIntervalS(), true);
+      break;
+    case INPUT_B_PRESS:
+      settingTelemetryRateIdx = (settingTelemetryRateIdx + 1) % TELEMETRY_RATE_COUNT;
+      saveConfig();
+      displayTelemetry(telemetryChannel, telemetryIntervalS(), true);
+      break;
+    case INPUT_PWR:
+      gameState.appState = telemetryReturn;
+      if (telemetryReturn == STATE_SYSTEM_INFO) displaySystemInfo();
+      else if (telemetryReturn == STATE_TEMPERATURE) displayTemperature();
+      else displayBatteryInfo();
+      break;
+    default:
+      break;
+  }
+}
+
 void handleGameStats(InputEvent evt) {
   if (evt == INPUT_A_LONG) {
     resetStats();
     audioDefeat();
     displayGameStats(statTotalMatches, statTotalPlaytimeSeconds,
-                     statPlayer1Wins, statPlayer2Wins,
+                     statPlayerWins,
                      statDiceRolls, statCoinFlips);
   } else if (evt == INPUT_PWR || evt == INPUT_B_PRESS) {
     gameState.appState = STATE_DIAGNOSTICS;
@@ -702,7 +1057,9 @@ void handleGameStats(InputEvent evt) {
 }
 
 void handleTemperature(InputEvent evt) {
-  if (evt == INPUT_PWR || evt == INPUT_A_PRESS || evt == INPUT_B_PRESS) {
+  if (evt == INPUT_A_PRESS) {
+    showTelemetry(TELE_TEMP_DC);
+  } else if (evt == INPUT_PWR || evt == INPUT_B_PRESS) {
     gameState.appState = STATE_DIAGNOSTICS;
     redrawDiagnostics();
   }
@@ -747,9 +1104,15 @@ void handleTestMenu(InputEvent evt) {
         case TEST_SPEAKER:
           gameState.appState = STATE_SPEAKER_TEST;
           speakerTestFrequency = 1000;
-          M5.Speaker.tone(speakerTestFrequency, 100);
+          audioTone(speakerTestFrequency, 100);
           displaySpeakerTest(speakerTestFrequency);
           break;
+        case TEST_BENCHMARK:
+          gameState.appState = STATE_BENCHMARK;
+          imuWake();
+          benchmarkBegin();
+          displayBenchmark();
+          break;
         case TEST_BACK:
           gameState.appState = STATE_DIAGNOSTICS;
           redrawDiagnostics();
@@ -851,13 +1214,13 @@ void handleSpeakerTest(InputEvent evt) {
     case INPUT_A_PRESS:
       speakerTestFrequency += 100;
       if (speakerTestFrequency > 2000) speakerTestFrequency = 2000;
-      M5.Speaker.tone(speakerTestFrequency, 100);
+      audioTone(speakerTestFrequency, 100);
       displaySpeakerTest(speakerTestFrequency);
       break;
     case INPUT_B_PRESS:
       speakerTestFrequency -= 100;
       if (speakerTestFrequency < 100) speakerTestFrequency = 100;
-      M5.Speaker.tone(speakerTestFrequency, 100);
+      audioTone(speakerTestFrequency, 100);
       displaySpeakerTest(speakerTestFrequency);
       break;
     case INPUT_PWR:
@@ -869,37 +1232,134 @@ void handleSpeakerTest(InputEvent evt) {
   }
 }
 
+// The suite runs one benchmark per loop pass, so [B] can leave between
+// two of them.
+void handleBenchmark(InputEvent evt) {
+  switch (evt) {
+    case INPUT_A_PRESS:
+      if (!benchmarkRunning()) {
+        benchmarkBegin();
+        displayBenchmark();
+      }
+      break;
+    case INPUT_PWR:
+    case INPUT_B_PRESS:
+      gameState.appState = STATE_TEST_MENU;
+      displayTestMenu(testMenuSel);
+      break;
+    default:
+      break;
+  }
+}
+
+bool loadBestRun(AppState game) {
+  char key[8];
+  snprintf(key, sizeof(key), "ghost%d", game - STATE_GAME_MANA_RUNNER);
+  MgRecording& rec = mgGhostSlot();
+  prefs.begin("mtg-config", true);
+  size_t len = prefs.isKey(key) ? prefs.getBytes(key, &rec, sizeof(rec)) : 0;
+  prefs.end();
+  return mgRecValid(rec, len) && rec.game == game - STATE_GAME_MANA_RUNNER;
+}
+
+// Keeps the highest-scoring run of each minigame for ghost races. A best
+// run that cannot become the ghost, because its inputs outgrew
+// MG_REC_BYTES or the flash write came up short, is reported on serial.
+void saveBestRun(AppState game, const MgRunResult& run) {
+  if (loadBestRun(game) && mgGhostSlot().score >= run.score) return;
+
+  uint8_t index = game - STATE_GAME_MANA_RUNNER;
+  if (!run.rec) {
+    Serial.printf("ghost err=overflow game=%u score=%u\n", index, run.score);
+    return;
+  }
+
+  char key[8];
+  snprintf(key, sizeof(key), "ghost%d", index);
+  size_t bytes = MG_REC_HEADER_BYTES + run.rec->length;
+  prefs.begin("mtg-config", false);
+  size_t written = prefs.putBytes(key, run.rec, bytes);
+  prefs.end();
+  if (written != bytes) {
+    Serial.printf("ghost err=write game=%u bytes=%u written=%u\n", index, (unsigned)bytes, (unsigned)written);
+  }
+}
+
+void saveLeaderboard() {
+  prefs.begin("mtg-config", false);
+  prefs.putBytes("mgboard", &mgBoard, sizeof(mgBoard));
+  prefs.end();
+}
+
+void showMgScores(uint8_t game, int8_t highlight) {
+  scoresGame = game;
+  gameState.appState = STATE_MG_SCORES;
+  displayMgScores(MINIGAMES[game].name, mgBoard.entries[game], highlight);
+}
+
+// Flash writes for a finished run wait until the player leaves the game,
+// so none of them lands inside the frame loop. A score that makes the
+// table asks for initials first.
+void leaveMinigame() {
+  AppState game = gameState.appState;
+  tiltStop();
+  MgRunResult run;
+  if (mgFinishedRun(run)) {
+    saveBestRun(game, run);
+    int8_t rank = mgBoardRank(mgBoard, run.game, run.score);
+    if (rank >= 0) {
+      memset(&pendingScore, 0, sizeof(pendingScore));
+      memcpy(pendingScore.initials, mgBoard.lastInitials, MG_INITIALS);
+      pendingScore.score = run.score;
+      uint32_t seconds = run.ticks / MG_TICK_HZ;
+      pendingScore.seconds = (seconds > 0xFFFF) ? 0xFFFF : seconds;
+      pendingScore.seed = run.seed;
+      pendingGame = run.game;
+      initialsPos = 0;
+      gameState.appState = STATE_MG_INITIALS;
+      displayMgInitials(MINIGAMES[pendingGame].name, run.score, rank, pendingScore.initials, initialsPos);
+      return;
+    }
+  }
+  gameState.appState = STATE_EASTER_EGGS_MENU;
+  redrawEasterEggsMenu();
+}
+
+void redrawEasterEggsMenu() {
+  displayEasterEggsMenu(easterEggsSel, EE_MODE_NAMES[easterEggsMode]);
+}
+
+// Ghost mode races the ghost of the best stored run, if there is one;
+// soak mode hands the game to the autoplay bot for soak testing, and
+// stress mode does the same with the entity pools kept full.
+void startMinigame(AppState game, MgMode mode) {
+  if (mode == MG_MODE_GHOST && !loadBestRun(game)) mode = MG_MODE_PLAY;
+  gameState.appState = game;
+  if (!joystickConnected && mode != MG_MODE_SOAK && mode != MG_MODE_STRESS) {
+    imuWake();
+    tiltStart();
+  }
+  mgInit(game, mode);
+}
+
 void handleEasterEggsMenu(InputEvent evt) {
   switch (evt) {
     case INPUT_B_PRESS:
       easterEggsSel = (easterEggsSel + 1) % EE_COUNT;
-      displayEasterEggsMenu(easterEggsSel);
+      redrawEasterEggsMenu();
       break;
     case INPUT_A_PRESS:
       audioConfirm();
-      switch ((EasterEggsOption)easterEggsSel) {
-        case EE_MANA_RUNNER:
-          gameState.appState = STATE_GAME_MANA_RUNNER;
-          mgInit(STATE_GAME_MANA_RUNNER);
-          break;
-        case EE_ARENA_BATTLE:
-          gameState.appState = STATE_GAME_ARENA;
-          mgInit(STATE_GAME_ARENA);
-          break;
-        case EE_SNAKE:
-          gameState.appState = STATE_GAME_SNAKE;
-          mgInit(STATE_GAME_SNAKE);
-          break;
-        case EE_SPELL_DODGE:
-          gameState.appState = STATE_GAME_SPELL_DODGE;
-          mgInit(STATE_GAME_SPELL_DODGE);
-          break;
-        case EE_BACK:
-          gameState.appState = STATE_DIAGNOSTICS;
-          redrawDiagnostics();
-          break;
-        default:
-          break;
+      if (easterEggsSel == EE_BACK) {
+        gameState.appState = STATE_DIAGNOSTICS;
+        redrawDiagnostics();
+      } else if (easterEggsSel == EE_SCORES) {
+        showMgScores(0, -1);
+      } else if (easterEggsSel == EE_MODE) {
+        easterEggsMode = (MgMode)((easterEggsMode + 1) % (MG_MODE_STRESS + 1));
+        redrawEasterEggsMenu();
+      } else {
+        startMinigame((AppState)(STATE_GAME_MANA_RUNNER + easterEggsSel), easterEggsMode);
       }
       break;
     case INPUT_PWR:
@@ -913,15 +1373,56 @@ void handleEasterEggsMenu(InputEvent evt) {
 
 void handleMinigame(InputEvent evt) {
   if (!mgIsAlive(gameState.appState)) {
-    if (evt == INPUT_A_PRESS || evt == INPUT_B_PRESS || evt == INPUT_PWR) {
-      gameState.appState = STATE_EASTER_EGGS_MENU;
-      displayEasterEggsMenu(easterEggsSel);
-    }
+    if (evt == INPUT_A_PRESS || evt == INPUT_B_PRESS || evt == INPUT_PWR) leaveMinigame();
     return;
   }
-  if (evt == INPUT_PWR) {
-    gameState.appState = STATE_EASTER_EGGS_MENU;
-    displayEasterEggsMenu(easterEggsSel);
+  if (evt == INPUT_PWR) leaveMinigame();
+  // [A] is free while steering by tilt: it takes the current pose as level.
+  else if (evt == INPUT_B_PRESS && !joystickConnected && tiltActive()) tiltCalibrate();
+}
+
+void handleMgInitials(InputEvent evt) {
+  char& c = pendingScore.initials[initialsPos];
+  switch (evt) {
+    case INPUT_A_PRESS:
+    case INPUT_A_LONG:
+      c = (c >= 'Z' || c < 'A') ? 'A' : c + 1;
+      break;
+    case INPUT_B_PRESS:
+    case INPUT_B_LONG:
+      c = (c <= 'A' || c > 'Z') ? 'Z' : c - 1;
+      break;
+    case INPUT_PWR: {
+      if (initialsPos + 1 < MG_INITIALS) {
+        initialsPos++;
+        break;
+      }
+      audioConfirm();
+      int8_t rank = mgBoardInsert(mgBoard, pendingGame, pendingScore);
+      memcpy(mgBoard.lastInitials, pendingScore.initials, MG_INITIALS);
+      saveLeaderboard();
+      showMgScores(pendingGame, rank);
+      return;
+    }
+    default:
+      return;
+  }
+  int8_t rank = mgBoardRank(mgBoard, pendingGame, pendingScore.score);
+  displayMgInitials(MINIGAMES[pendingGame].name, pendingScore.score, rank, pendingScore.initials, initialsPos);
+}
+
+void handleMgScores(InputEvent evt) {
+  switch (evt) {
+    case INPUT_B_PRESS:
+      showMgScores((scoresGame + 1) % MINIGAME_COUNT, -1);
+      break;
+    case INPUT_A_PRESS:
+    case INPUT_PWR:
+      gameState.appState = STATE_EASTER_EGGS_MENU;
+      redrawEasterEggsMenu();
+      break;
+    default:
+      break;
   }
 }
 
@@ -950,8 +1451,270 @@ void handleConfirmReset(InputEvent evt) {
   }
 }
 
+// === Serial console ===
+// One command per loop pass, parsed before input handling so it never
+// lands inside a frame. Replies start with "ok" or "err", dumps with
+// their name; see README for the command list.
+InputEvent consoleEvent = INPUT_NONE;
+bool consoleProfiling = false;
+
+const ConsoleName CONSOLE_EVENTS[] = {
+  { "ok", INPUT_A_PRESS },
+  { "a", INPUT_B_PRESS },
+  { "ok-long", INPUT_A_LONG },
+  { "a-long", INPUT_B_LONG },
+  { "b", INPUT_PWR },
+  { "shake", INPUT_SHAKE }
+};
+
+const ConsoleName CONSOLE_STATES[] = {
+  { "menu", STATE_MAIN_MENU },
+  { "game", STATE_GAME },
+  { "settings", STATE_SETTINGS },
+  { "about", STATE_ABOUT },
+  { "diag", STATE_DIAGNOSTICS },
+  { "battery", STATE_BATTERY_INFO },
+  { "system", STATE_SYSTEM_INFO },
+  { "perf", STATE_PERF },
+  { "stats", STATE_GAME_STATS },
+  { "temp", STATE_TEMPERATURE },
+  { "imu", STATE_IMU_STATUS },
+  { "tests", STATE_TEST_MENU },
+  { "benchmark", STATE_BENCHMARK },
+  { "telemetry", STATE_TELEMETRY },
+  { "eggs", STATE_EASTER_EGGS_MENU },
+  { "scores", STATE_MG_SCORES },
+  { "runner", STATE_GAME_MANA_RUNNER },
+  { "arena", STATE_GAME_ARENA },
+  { "snake", STATE_GAME_SNAKE },
+  { "dodge", STATE_GAME_SPELL_DODGE }
+};
+
+const ConsoleName CONSOLE_CURVES[] = {
+  { "linear", JOYSTICK_CURVE_LINEAR },
+  { "square", JOYSTICK_CURVE_SQUARE },
+  { "cubic", JOYSTICK_CURVE_CUBIC }
+};
+
+const char* consoleStateName(AppState state) {
+  for (const ConsoleName& s : CONSOLE_STATES) {
+    if (s.value == state) return s.name;
+  }
+  return "-";
+}
+
+// Shows a state the way its menu entry would. A running minigame is
+// abandoned without recording the run.
+bool consoleJump(AppState state) {
+  bool inMinigame = (gameState.appState >= STATE_GAME_MANA_RUNNER && gameState.appState <= STATE_GAME_SPELL_DODGE);
+  bool toMinigame = (state >= STATE_GAME_MANA_RUNNER && state <= STATE_GAME_SPELL_DODGE);
+  if ((toMinigame || state == STATE_EASTER_EGGS_MENU || state == STATE_MG_SCORES) && !diagHasEasterEggs) return false;
+  if (state == STATE_GAME && gameState.playerCount == 0) return false;
+  if (inMinigame) tiltStop();
+  inGameMenu = false;
+
+  if (toMinigame) {
+    startMinigame(state, MG_MODE_PLAY);
+    return true;
+  }
+  if (state == STATE_MG_SCORES) {
+    showMgScores(0, -1);
+    return true;
+  }
+  if (state == STATE_TELEMETRY) {
+    // Open it as if from the battery page, so [B] leads somewhere it can draw.
+    gameState.appState = STATE_BATTERY_INFO;
+    showTelemetry(TELE_BATT_MV);
+    return true;
+  }
+  gameState.appState = state;
+  switch (state) {
+    case STATE_MAIN_MENU: displayMainMenu(mainMenuSel); break;
+    case STATE_GAME: displayInvalidate(); displayGame(gameState, settingTimerMode); break;
+    case STATE_SETTINGS: redrawSettings(); break;
+    case STATE_ABOUT: displayAbout(); break;
+    case STATE_DIAGNOSTICS: redrawDiagnostics(); break;
+    case STATE_BATTERY_INFO: displayBatteryInfo(); break;
+    case STATE_SYSTEM_INFO: displaySystemInfo(); break;
+    case STATE_PERF: redrawPerf(); break;
+    case STATE_GAME_STATS:
+      displayGameStats(statTotalMatches, statTotalPlaytimeSeconds, statPlayerWins, statDiceRolls, statCoinFlips);
+      break;
+    case STATE_TEMPERATURE: displayTemperature(); break;
+    case STATE_IMU_STATUS: displayIMUStatus(); break;
+    case STATE_TEST_MENU: displayTestMenu(testMenuSel); break;
+    case STATE_BENCHMARK: imuWake(); benchmarkBegin(); displayBenchmark(); break;
+    case STATE_EASTER_EGGS_MENU: redrawEasterEggsMenu(); break;
+    default: break;
+  }
+  return true;
+}
+
+void consoleDumpGame(bool binary) {
+  if (binary) {
+    consoleHex(Serial, "game", &gameState, sizeof(gameState));
+    return;
+  }
+  Serial.printf("game state=%d/%s players=%u active=%u start=%d alive=0x%02X over=%u winner=%u timer=%u secs=%lu life=",
+                gameState.appState, consoleStateName(gameState.appState), gameState.playerCount, gameState.activePlayer,
+                gameState.startingLife, gameState.aliveMask, gameState.gameOver, gameState.winnerIndex,
+                gameState.timerRunning, gameGetMatchSeconds(gameState));
+  for (uint8_t i = 0; i < gameState.playerCount; i++) {
+    Serial.printf(i ? ",%d" : "%d", gameState.players.life[i]);
+  }
+  // Only counters that are set, as p<player>.<label>=<value>.
+  char label[16];
+  for (uint8_t i = 0; i < gameState.playerCount; i++) {
+    for (uint8_t slot = 0; slot < COUNTER_SLOTS; slot++) {
+      int16_t v = counterGet(gameState.counters, i, slot);
+      if (v == 0) continue;
+      counterLabel(slot, label, sizeof(label));
+      Serial.printf(" p%u.%s=%d", i, label, v);
+    }
+  }
+  Serial.println();
+}
+
+void consoleDumpStats(bool binary) {
+  struct __attribute__((packed)) {
+    uint16_t matches;
+    uint32_t playtime;
+    uint16_t wins[MAX_PLAYERS];
+    uint16_t dice;
+    uint16_t coins;
+  } s;
+  s.matches = statTotalMatches;
+  s.playtime = statTotalPlaytimeSeconds;
+  memcpy(s.wins, statPlayerWins, sizeof(s.wins));
+  s.dice = statDiceRolls;
+  s.coins = statCoinFlips;
+  if (binary) {
+    consoleHex(Serial, "stats", &s, sizeof(s));
+    return;
+  }
+  Serial.printf("stats matches=%u playtime=%lu dice=%u coins=%u wins=", s.matches, (unsigned long)s.playtime, s.dice, s.coins);
+  for (uint8_t i = 0; i < MAX_PLAYERS; i++) Serial.printf(i ? ",%u" : "%u", s.wins[i]);
+  Serial.println();
+}
+
+void consoleDumpSettings(bool binary) {
+  uint8_t s[] = {
+    settingBrightness, settingVolume, (uint8_t)settingTimerMode, (uint8_t)settingTheme,
+    settingFaceDownPause, settingShutdownIdleIdx, settingShutdownGameIdx, settingPerfHud,
+    settingTelemetryRateIdx
+  };
+  if (binary) {
+    consoleHex(Serial, "settings", s, sizeof(s));
+    return;
+  }
+  Serial.printf("settings brightness=%u volume=%u timer=%u theme=%u facedown=%u idle=%u ingame=%u hud=%u telerate=%us\n",
+                s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], telemetryIntervalS());
+}
+
+void consoleDumpPerf(bool binary) {
+  const PerfStats& ps = perfGetStats();
+  TiltStats ts = tiltGetStats();
+  if (binary) {
+    consoleHex(Serial, "perf", &ps, sizeof(ps));
+    return;
+  }
+  Serial.printf("perf loops=%lu avg=%lu p99=%lu max=%lu blocked=%u heap=%lu minheap=%lu i2c=%lu spi=%lu",
+                (unsigned long)ps.loopsPerSec, (unsigned long)ps.frameAvgUs, (unsigned long)ps.frameP99Us,
+                (unsigned long)ps.frameMaxUs, ps.blockedPct, (unsigned long)ps.freeHeap,
+                (unsigned long)ps.minFreeHeap, (unsigned long)ps.i2cPerSec, (unsigned long)ps.spiBytesPerSec);
+  for (uint8_t i = 0; i < ps.taskCount; i++) {
+    Serial.printf(" stack.%s=%lu", ps.tasks[i].name, (unsigned long)ps.tasks[i].stackFree);
+  }
+  Serial.printf(" tilt.samples=%lu tilt.us=%u tilt.max=%u tilt.over=%lu tilt.read=%u",
+                (unsigned long)ts.samples, ts.meanUs, ts.maxUs, (unsigned long)ts.overruns, ts.readUs);
+  Serial.println();
+}
+
+bool consoleOnOff(const char* arg, bool& value) {
+  if (strcmp(arg, "on") == 0) value = true;
+  else if (strcmp(arg, "off") == 0) value = false;
+  else return false;
+  return true;
+}
+
+void consoleCommand(uint8_t argc, char* argv[]) {
+  const char* cmd = argv[0];
+  const char* arg = (argc > 1) ? argv[1] : "";
+
+  if (strcmp(cmd, "help") == 0) {
+    Serial.println("ok press <ok|a|b|ok-long|a-long|shake> | state [name] | dump <game|stats|settings|perf> [bin] | prof <on|off> | hud <on|off> | stick <cal|linear|square|cubic> [deadzone%]");
+  } else if (strcmp(cmd, "press") == 0) {
+    int16_t evt = consoleLookup(CONSOLE_EVENTS, sizeof(CONSOLE_EVENTS) / sizeof(CONSOLE_EVENTS[0]), arg);
+    if (evt < 0) {
+      Serial.println("err unknown button");
+      return;
+    }
+    consoleEvent = (InputEvent)evt;
+    Serial.println("ok");
+  } else if (strcmp(cmd, "state") == 0) {
+    if (argc > 1) {
+      int16_t state = consoleLookup(CONSOLE_STATES, sizeof(CONSOLE_STATES) / sizeof(CONSOLE_STATES[0]), arg);
+      if (state < 0 || !consoleJump((AppState)state)) {
+        Serial.println("err unavailable state");
+        return;
+      }
+    }
+    Serial.printf("ok %d %s\n", gameState.appState, consoleStateName(gameState.appState));
+  } else if (strcmp(cmd, "dump") == 0) {
+    bool binary = (argc > 2 && strcmp(argv[2], "bin") == 0);
+    if (strcmp(arg, "game") == 0) consoleDumpGame(binary);
+    else if (strcmp(arg, "stats") == 0) consoleDumpStats(binary);
+    else if (strcmp(arg, "settings") == 0) consoleDumpSettings(binary);
+    else if (strcmp(arg, "perf") == 0) consoleDumpPerf(binary);
+    else Serial.println("err unknown dump");
+  } else if (strcmp(cmd, "prof") == 0) {
+    if (!consoleOnOff(arg, consoleProfiling)) {
+      Serial.println("err expected on|off");
+      return;
+    }
+    Serial.println("ok");
+  } else if (strcmp(cmd, "hud") == 0) {
+    if (!consoleOnOff(arg, settingPerfHud)) {
+      Serial.println("err expected on|off");
+      return;
+    }
+    displaySetPerfOverlay(settingPerfHud);
+    saveConfig();
+    Serial.println("ok");
+  } else if (strcmp(cmd, "stick") == 0) {
+    if (strcmp(arg, "cal") == 0) {
+      joystickRecalibrate();
+      Serial.println("ok");
+      return;
+    }
+    int16_t curve = consoleLookup(CONSOLE_CURVES, sizeof(CONSOLE_CURVES) / sizeof(CONSOLE_CURVES[0]), arg);
+    if (curve < 0) {
+      Serial.println("err expected cal|linear|square|cubic");
+      return;
+    }
+    int deadzone = (argc > 2) ? atoi(argv[2]) : JOYSTICK_DEADZONE_PCT;
+    if (deadzone < 0 || deadzone > 90) {
+      Serial.println("err deadzone 0-90");
+      return;
+    }
+    joystickSetResponse(deadzone, (JoystickCurve)curve);
+    Serial.println("ok");
+  } else {
+    Serial.println("err unknown command");
+  }
+}
+
+void pollConsole() {
+  char* argv[CONSOLE_MAX_ARGS];
+  uint8_t argc = consolePoll(Serial, argv);
+  if (argc > 0) consoleCommand(argc, argv);
+}
+
 void setup() {
+  prngInit();
+
   auto cfg = M5.config();
+  cfg.serial_baudrate = SERIAL_BAUD;
   M5.begin(cfg);
 
   WiFi.mode(WIFI_OFF);
@@ -960,6 +1723,8 @@ void setup() {
   loadConfig();
 
   displayInit();
+  displaySetPerfOverlay(settingPerfHud);
+  perfWatchTask(xTaskGetCurrentTaskHandle(), "loop");
   audioInit();
   inputInit(inputState);
 
@@ -967,8 +1732,6 @@ void setup() {
   M5.Speaker.setVolume(settingVolume);
   displaySetTheme(settingTheme);
 
-  randomSeed(analogRead(0) ^ micros());
-
   joystickInit();
 
   displayStartup();
@@ -982,6 +1745,7 @@ void setup() {
   lastActivityMs = millis();
 
   imuSleep();
+  sampleTelemetry();
 }
 
 bool shouldRefresh(unsigned long &lastTime, unsigned long interval) {
@@ -993,9 +1757,15 @@ bool shouldRefresh(unsigned long &lastTime, unsigned long interval) {
 }
 
 void loop() {
+  bool perfFresh = perfLoopBegin();
   M5.update();
+  pollConsole();
 
   InputEvent evt = inputUpdate(inputState);
+  if (evt == INPUT_NONE) {
+    evt = consoleEvent;
+    consoleEvent = INPUT_NONE;
+  }
 
   if (evt != INPUT_NONE) {
     resetActivity();
@@ -1008,8 +1778,13 @@ void loop() {
       case STATE_MAIN_MENU: handleMainMenu(evt); break;
       case STATE_GAME_MODE_SELECT: handleGameModeSelect(evt); break;
       case STATE_CUSTOM_LIFE_INPUT: handleCustomLifeInput(evt); break;
+      case STATE_PLAYER_COUNT_SELECT: handlePlayerCountSelect(evt); break;
       case STATE_PLAYER_THEME_SELECT: handlePlayerThemeSelect(evt); break;
       case STATE_GAME: handleGame(evt); break;
+      case STATE_COUNTERS: handleCounters(evt); break;
+      case STATE_QUICK_ENTRY: handleQuickEntry(evt); break;
+      case STATE_MATCH_REPLAY: handleMatchReplay(evt); break;
+      case STATE_TURN_STATS: handleTurnStats(evt); break;
       case STATE_DICE: handleDice(evt); break;
       case STATE_COIN: handleCoin(evt); break;
       case STATE_SETTINGS: handleSettings(evt); break;
@@ -1017,6 +1792,8 @@ void loop() {
       case STATE_DIAGNOSTICS: handleDiagnostics(evt); break;
       case STATE_BATTERY_INFO: handleBatteryInfo(evt); break;
       case STATE_SYSTEM_INFO: handleSystemInfo(evt); break;
+      case STATE_PERF: handlePerf(evt); break;
+      case STATE_TELEMETRY: handleTelemetry(evt); break;
       case STATE_GAME_STATS: handleGameStats(evt); break;
       case STATE_TEMPERATURE: handleTemperature(evt); break;
       case STATE_IMU_STATUS: handleIMUStatus(evt); break;
@@ -1025,16 +1802,24 @@ void loop() {
       case STATE_BUTTON_TEST: handleButtonTest(evt); break;
       case STATE_SCREEN_TEST: handleScreenTest(evt); break;
       case STATE_SPEAKER_TEST: handleSpeakerTest(evt); break;
+      case STATE_BENCHMARK: handleBenchmark(evt); break;
       case STATE_CONFIRM_RESET: handleConfirmReset(evt); break;
       case STATE_EASTER_EGGS_MENU: handleEasterEggsMenu(evt); break;
       case STATE_GAME_MANA_RUNNER:
       case STATE_GAME_ARENA:
       case STATE_GAME_SNAKE:
       case STATE_GAME_SPELL_DODGE: handleMinigame(evt); break;
+      case STATE_MG_INITIALS: handleMgInitials(evt); break;
+      case STATE_MG_SCORES: handleMgScores(evt); break;
     }
   }
 
   static unsigned long lastRefresh = 0;
+  updateResultAnimation();
+
+  if (gameState.appState == STATE_GAME && !inGameMenu) {
+    checkChessClock();
+  }
   if (gameState.appState == STATE_GAME && !inGameMenu && !gameState.gameOver) {
     if (millis() - lastRefresh > 1000) {
       lastRefresh = millis();
@@ -1055,6 +1840,16 @@ void loop() {
     displayTemperature();
   if (gameState.appState == STATE_IMU_STATUS && shouldRefresh(lastIMURefresh, 100))
     displayIMUStatus();
+  if (gameState.appState == STATE_BENCHMARK && benchmarkRunning()) {
+    benchmarkStep();
+    displayBenchmark();
+    if (!benchmarkRunning()) benchmarkPrint(Serial);
+  }
+  if (perfFresh) {
+    if (consoleProfiling) consoleDumpPerf(false);
+    if (gameState.appState == STATE_PERF) redrawPerf();
+    else displayPerfOverlay();
+  }
 
   if (gameState.appState != lastAppState) {
     bool shouldBeAwake = imuShouldBeAwake(gameState.appState);
@@ -1066,6 +1861,11 @@ void loop() {
     lastAppState = gameState.appState;
   }
 
+  if (millis() - lastTelemetryMs >= telemetryIntervalS() * 1000UL) {
+    sampleTelemetry();
+    if (gameState.appState == STATE_TELEMETRY) displayTelemetry(telemetryChannel, telemetryIntervalS(), false);
+  }
+
   if (millis() - lastPowerCheckMs > POWER_CHECK_INTERVAL_MS) {
     lastPowerCheckMs = millis();
     checkPowerSaving();
@@ -1076,16 +1876,17 @@ void loop() {
     checkFaceDown();
   }
 
-  static unsigned long lastGameFrame = 0;
-  if (gameState.appState >= STATE_GAME_MANA_RUNNER && gameState.appState <= STATE_GAME_SPELL_DODGE) {
-    if (millis() - lastGameFrame >= 50) {
-      lastGameFrame = millis();
+  bool inMinigame = (gameState.appState >= STATE_GAME_MANA_RUNNER && gameState.appState <= STATE_GAME_SPELL_DODGE);
+  if (inMinigame) {
+    if (joystickConnected) {
       joystickRead(joystickState);
-      if (mgIsAlive(gameState.appState)) {
-        mgUpdate(gameState.appState, joystickState);
-      }
-      mgRender(gameState.appState);
+    } else if (tiltActive()) {
+      tiltRead(joystickState);
+      joystickState.button = M5.BtnA.isPressed();
     }
+    mgFrame(gameState.appState, joystickState);
+    // A soak test runs unattended for hours; keep the auto power-off away.
+    if (mgSoaking()) lastActivityMs = millis();
   }
 
   unsigned long shutdownTimeout = gameState.timerRunning
@@ -1102,5 +1903,7 @@ void loop() {
     M5.Power.powerOff();
   }
 
-  delay(10);
+  if (!inMinigame) {
+    perfDelay(10);
+  }
 }
@@ -0,0 +1,93 @@
+#include "perf.h"
+#include <string.h>
+
+volatile uint32_t perfI2CCount = 0;
+volatile uint32_t perfSpiBytes = 0;
+
+static PerfStats stats;
+static TaskHandle_t watched[PERF_MAX_TASKS];
+
+static uint16_t frameHist[PERF_HIST_BUCKETS];
+static uint32_t windowStartUs = 0;
+static uint32_t lastLoopUs = 0;
+static uint32_t loops = 0;
+static uint32_t frameSumUs = 0;
+static uint32_t frameMaxUs = 0;
+static uint32_t blockedUs = 0;
+static uint32_t i2cBase = 0;
+static uint32_t spiBase = 0;
+
+// Upper edge of the bucket holding the 99th percentile; the last bucket
+// also holds everything slower.
+static uint32_t histP99() {
+  uint32_t skip = loops / 100;
+  uint32_t seen = 0;
+  for (uint16_t b = PERF_HIST_BUCKETS; b-- > 0;) {
+    seen += frameHist[b];
+    if (seen > skip) return (b + 1) * PERF_HIST_BUCKET_US;
+  }
+  return 0;
+}
+
+static void closeWindow(uint32_t now) {
+  uint32_t span = now - windowStartUs;
+  uint32_t i2c = perfI2CCount;
+  uint32_t spi = perfSpiBytes;
+
+  stats.loopsPerSec = (uint64_t)loops * 1000000 / span;
+  stats.frameAvgUs = loops ? frameSumUs / loops : 0;
+  stats.frameP99Us = histP99();
+  stats.frameMaxUs = frameMaxUs;
+  stats.blockedPct = (uint64_t)blockedUs * 100 / span;
+  stats.i2cPerSec = (uint64_t)(i2c - i2cBase) * 1000000 / span;
+  stats.spiBytesPerSec = (uint64_t)(spi - spiBase) * 1000000 / span;
+  stats.freeHeap = ESP.getFreeHeap();
+  stats.minFreeHeap = ESP.getMinFreeHeap();
+  for (uint8_t i = 0; i < stats.taskCount; i++) {
+    stats.tasks[i].stackFree = uxTaskGetStackHighWaterMark(watched[i]);
+  }
+
+  memset(frameHist, 0, sizeof(frameHist));
+  windowStartUs = now;
+  loops = frameSumUs = frameMaxUs = blockedUs = 0;
+  i2cBase = i2c;
+  spiBase = spi;
+}
+
+bool perfLoopBegin() {
+  uint32_t now = micros();
+  if (windowStartUs == 0) {
+    windowStartUs = lastLoopUs = now;
+    return false;
+  }
+
+  uint32_t frame = now - lastLoopUs;
+  lastLoopUs = now;
+  uint32_t bucket = frame / PERF_HIST_BUCKET_US;
+  frameHist[bucket < PERF_HIST_BUCKETS ? bucket : PERF_HIST_BUCKETS - 1]++;
+  frameSumUs += frame;
+  if (frame > frameMaxUs) frameMaxUs = frame;
+  loops++;
+
+  if (now - windowStartUs < PERF_WINDOW_MS * 1000UL) return false;
+  closeWindow(now);
+  return true;
+}
+
+void perfDelay(uint32_t ms) {
+  uint32_t t0 = micros();
+  delay(ms);
+  blockedUs += micros() - t0;
+}
+
+void perfWatchTask(TaskHandle_t task, const char* name) {
+  if (!task || stats.taskCount >= PERF_MAX_TASKS) return;
+  watched[stats.taskCount] = task;
+  stats.tasks[stats.taskCount].name = name;
+  stats.tasks[stats.taskCount].stackFree = uxTaskGetStackHighWaterMark(task);
+  stats.taskCount++;
+}
+
+const PerfStats& perfGetStats() {
+  return stats;
+}
@@ -0,0 +1,53 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <Arduino.h>
+
+// Always-on runtime counters. The hot paths only bump integers; once per
+// PERF_WINDOW_MS the loop folds them into a PerfStats snapshot, which is
+// also when heap and stack marks are queried.
+#define PERF_WINDOW_MS      1000
+#define PERF_HIST_BUCKETS   128
+#define PERF_HIST_BUCKET_US 250
+#define PERF_MAX_TASKS      6
+
+struct PerfTaskInfo {
+  const char* name;
+  uint32_t stackFree;
+};
+
+struct PerfStats {
+  uint32_t loopsPerSec;
+  uint32_t frameAvgUs;
+  uint32_t frameP99Us;
+  uint32_t frameMaxUs;
+  uint8_t blockedPct;
+  uint32_t freeHeap;
+  uint32_t minFreeHeap;
+  uint32_t i2cPerSec;
+  uint32_t spiBytesPerSec;
+  uint8_t taskCount;
+  PerfTaskInfo tasks[PERF_MAX_TASKS];
+};
+
+extern volatile uint32_t perfI2CCount;
+extern volatile uint32_t perfSpiBytes;
+
+// I2C is used from several tasks on both cores, so the adds are atomic.
+static inline void perfCountI2C(uint32_t n = 1) {
+  __atomic_fetch_add(&perfI2CCount, n, __ATOMIC_RELAXED);
+}
+
+static inline void perfCountSpi(uint32_t bytes) {
+  __atomic_fetch_add(&perfSpiBytes, bytes, __ATOMIC_RELAXED);
+}
+
+// Call first thing in loop(). Returns true when a new snapshot is ready.
+bool perfLoopBegin();
+// delay() that is counted as time the loop spent blocked.
+void perfDelay(uint32_t ms);
+// Adds a task to the stack high-water report; name must outlive it.
+void perfWatchTask(TaskHandle_t task, const char* name);
+const PerfStats& perfGetStats();
+
+#endif
@@ -0,0 +1,46 @@
+#include "prng.h"
+#include "config.h"
+#include <Arduino.h>
+#include <bootloader_random.h>
+
+static PrngState streams[PRNG_STREAM_COUNT];
+static uint32_t currentSeed = 0;
+
+void prngInit() {
+#if PRNG_FIXED_SEED
+  prngSeed(PRNG_FIXED_SEED);
+#else
+  // With the radio off the hardware RNG only has real entropy while the
+  // SAR ADC noise source is enabled, so this must run before M5.begin()
+  // configures the ADC for battery readings.
+  bootloader_random_enable();
+  uint32_t seed = esp_random();
+  bootloader_random_disable();
+  prngSeed(seed);
+#endif
+}
+
+void prngSeed(uint32_t seed) {
+  currentSeed = seed;
+  for (uint8_t i = 0; i < PRNG_STREAM_COUNT; i++) {
+    prngStateSeed(streams[i], seed, i);
+  }
+}
+
+uint32_t prngGetSeed() {
+  return currentSeed;
+}
+
+uint32_t prngNext(PrngStream stream) {
+  return prngStateNext(streams[stream]);
+}
+
+uint32_t prngBelow(PrngStream stream, uint32_t bound) {
+  if (bound == 0) return 0;
+  return prngStateBelow(streams[stream], bound);
+}
+
+int32_t prngRange(PrngStream stream, int32_t lo, int32_t hi) {
+  if (hi <= lo) return lo;
+  return lo + (int32_t)prngBelow(stream, (uint32_t)(hi - lo));
+}
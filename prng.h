@@ -0,0 +1,71 @@
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+
+// xoshiro128** core with Lemire's unbiased bounded sampling. The inline
+// core has no Arduino dependencies so host tools can include this header.
+
+struct PrngState {
+  uint32_t s[4];
+};
+
+enum PrngStream {
+  PRNG_DICE,
+  PRNG_COIN,
+  PRNG_ANIMATION,
+  PRNG_MINIGAME,
+  PRNG_STREAM_COUNT
+};
+
+static inline uint32_t prngRotl(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t prngSplitMix(uint32_t& x) {
+  uint32_t z = (x += 0x9E3779B9u);
+  z = (z ^ (z >> 16)) * 0x21F0AAADu;
+  z = (z ^ (z >> 15)) * 0x735A2D97u;
+  return z ^ (z >> 15);
+}
+
+static inline void prngStateSeed(PrngState& st, uint32_t seed, uint32_t stream) {
+  uint32_t x = seed ^ (stream * 0x632BE5ABu);
+  for (int i = 0; i < 4; i++) st.s[i] = prngSplitMix(x);
+  if ((st.s[0] | st.s[1] | st.s[2] | st.s[3]) == 0) st.s[0] = 1;
+}
+
+static inline uint32_t prngStateNext(PrngState& st) {
+  uint32_t* s = st.s;
+  uint32_t result = prngRotl(s[1] * 5, 7) * 9;
+  uint32_t t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = prngRotl(s[3], 11);
+  return result;
+}
+
+static inline uint32_t prngStateBelow(PrngState& st, uint32_t bound) {
+  uint64_t m = (uint64_t)prngStateNext(st) * bound;
+  uint32_t low = (uint32_t)m;
+  if (low < bound) {
+    uint32_t threshold = (0u - bound) % bound;
+    while (low < threshold) {
+      m = (uint64_t)prngStateNext(st) * bound;
+      low = (uint32_t)m;
+    }
+  }
+  return (uint32_t)(m >> 32);
+}
+
+void prngInit();
+void prngSeed(uint32_t seed);
+uint32_t prngGetSeed();
+uint32_t prngNext(PrngStream stream);
+uint32_t prngBelow(PrngStream stream, uint32_t bound);
+int32_t prngRange(PrngStream stream, int32_t lo, int32_t hi);
+
+#endif
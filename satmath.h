@@ -0,0 +1,27 @@
+#ifndef SATMATH_H
+#define SATMATH_H
+
+#include <stdint.h>
+
+// Saturating arithmetic for narrow counter types. The sum is formed in a
+// 32-bit register and clamped with min/max, which GCC lowers to MIN/MAX on
+// Xtensa (and CMOV on x86), so there are no branches on the hot path.
+
+template <typename T>
+static inline T satClamp(int32_t v, T lo, T hi) {
+  static_assert(sizeof(T) < sizeof(int32_t), "satmath works on types narrower than 32 bits");
+  int32_t a = v > (int32_t)lo ? v : (int32_t)lo;
+  return (T)(a < (int32_t)hi ? a : (int32_t)hi);
+}
+
+template <typename T>
+static inline T satAdd(T a, int32_t b, T lo, T hi) {
+  return satClamp<T>((int32_t)a + b, lo, hi);
+}
+
+template <typename T>
+static inline T satSub(T a, int32_t b, T lo, T hi) {
+  return satClamp<T>((int32_t)a - b, lo, hi);
+}
+
+#endif
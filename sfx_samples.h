@@ -0,0 +1,33 @@
+#ifndef SFX_SAMPLES_H
+#define SFX_SAMPLES_H
+
+#include <Arduino.h>
+
+// 8-bit signed PCM at SFX_SAMPLE_RATE. SAMPLE_THUMP is a 40 ms decaying
+// 110 -> 50 Hz sine with a short noise transient, used for minigame hits.
+#define SFX_SAMPLE_RATE 8000
+
+static const int8_t SAMPLE_THUMP[] PROGMEM = {
+  -1, 20, 23, 39, 48, 37, 43, 75, 64, 69, 95, 84, 97, 91, 96, 86,
+  98, 103, 95, 98, 94, 80, 90, 83, 74, 65, 73, 61, 59, 56, 47, 43,
+  29, 28, 16, 16, 8, -8, -14, -19, -17, -29, -32, -41, -44, -49, -54, -56,
+  -59, -60, -64, -64, -66, -67, -70, -73, -69, -68, -67, -67, -65, -65, -60, -58,
+  -56, -54, -47, -42, -42, -35, -32, -28, -23, -17, -12, -10, -3, -1, 6, 9,
+  15, 19, 22, 27, 29, 32, 36, 37, 40, 43, 46, 47, 48, 51, 51, 52,
+  53, 52, 52, 51, 51, 50, 48, 47, 46, 43, 41, 39, 37, 34, 32, 29,
+  26, 23, 20, 17, 14, 11, 8, 4, 2, -1, -4, -7, -10, -12, -15, -18,
+  -20, -22, -24, -26, -28, -30, -31, -33, -34, -34, -35, -36, -36, -37, -37, -37,
+  -37, -36, -36, -35, -35, -34, -32, -31, -30, -29, -27, -26, -24, -23, -21, -19,
+  -17, -15, -13, -11, -9, -8, -6, -4, -2, 0, 2, 4, 6, 7, 9, 11,
+  12, 13, 15, 16, 17, 19, 20, 21, 21, 22, 23, 24, 24, 24, 25, 25,
+  25, 25, 25, 25, 25, 25, 24, 24, 23, 23, 22, 21, 21, 20, 19, 18,
+  17, 16, 15, 14, 13, 12, 11, 10, 9, 7, 6, 5, 4, 3, 2, 1,
+  0, -1, -2, -3, -4, -5, -6, -7, -8, -9, -10, -10, -11, -12, -12, -13,
+  -13, -14, -14, -15, -15, -15, -16, -16, -16, -16, -16, -16, -16, -16, -16, -16,
+  -16, -16, -15, -15, -15, -14, -14, -14, -13, -13, -12, -12, -11, -11, -10, -10,
+  -9, -9, -8, -8, -7, -7, -6, -5, -5, -4, -4, -3, -2, -2, -1, -1,
+  0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 6, 7,
+  7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+};
+
+#endif
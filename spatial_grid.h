@@ -0,0 +1,80 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <stdint.h>
+
+// Fixed-memory uniform-grid broadphase. Items are points (an entity's
+// top-left corner); callers pad queries by the largest entity size.
+//
+// Each tick: begin(), add() every live item, build(). build() is a
+// counting sort by cell, O(items + cells), so the items of a cell sit
+// contiguously in sorted[] and a query only touches the cells it
+// overlaps. Points outside the field clamp into the border cells.
+//
+// Kept free of Arduino headers so host benchmarks can include it.
+template <uint16_t MAX_ITEMS, int16_t WIDTH, int16_t HEIGHT, uint8_t CELL_SHIFT = 4>
+struct SpatialGrid {
+  static const uint8_t COLS = (WIDTH + (1 << CELL_SHIFT) - 1) >> CELL_SHIFT;
+  static const uint8_t ROWS = (HEIGHT + (1 << CELL_SHIFT) - 1) >> CELL_SHIFT;
+  static const uint16_t CELLS = COLS * ROWS;
+
+  uint16_t cellStart[CELLS + 1];
+  uint16_t itemId[MAX_ITEMS];
+  uint16_t itemCell[MAX_ITEMS];
+  uint16_t sorted[MAX_ITEMS];
+  uint16_t count;
+
+  static int16_t clampCol(float x) {
+    int16_t c = (int16_t)x >> CELL_SHIFT;
+    return c < 0 ? 0 : (c >= COLS ? COLS - 1 : c);
+  }
+
+  static int16_t clampRow(float y) {
+    int16_t r = (int16_t)y >> CELL_SHIFT;
+    return r < 0 ? 0 : (r >= ROWS ? ROWS - 1 : r);
+  }
+
+  void begin() {
+    count = 0;
+    for (uint16_t c = 0; c <= CELLS; c++) cellStart[c] = 0;
+  }
+
+  bool add(uint16_t id, float x, float y) {
+    if (count >= MAX_ITEMS) return false;
+    uint16_t cell = clampRow(y) * COLS + clampCol(x);
+    itemId[count] = id;
+    itemCell[count] = cell;
+    cellStart[cell + 1]++;
+    count++;
+    return true;
+  }
+
+  void build() {
+    for (uint16_t c = 0; c < CELLS; c++) cellStart[c + 1] += cellStart[c];
+    // cellStart[c] is now the first slot of cell c; fill each cell from its
+    // end backwards so the pass leaves cellStart untouched.
+    uint16_t fill[CELLS];
+    for (uint16_t c = 0; c < CELLS; c++) fill[c] = cellStart[c + 1];
+    for (uint16_t i = count; i-- > 0;) {
+      sorted[--fill[itemCell[i]]] = itemId[i];
+    }
+  }
+
+  // Calls visit(id) for every item whose cell overlaps [x0,x1] x [y0,y1].
+  // Candidates only: the caller does the exact overlap test.
+  template <typename F>
+  void query(float x0, float y0, float x1, float y1, F&& visit) const {
+    int16_t c0 = clampCol(x0), c1 = clampCol(x1);
+    int16_t r0 = clampRow(y0), r1 = clampRow(y1);
+    for (int16_t r = r0; r <= r1; r++) {
+      for (int16_t c = c0; c <= c1; c++) {
+        uint16_t cell = r * COLS + c;
+        for (uint16_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+          visit(sorted[k]);
+        }
+      }
+    }
+  }
+};
+
+#endif
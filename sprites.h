@@ -0,0 +1,423 @@
+// Generated by tools/spritegen.py from sprites/*.spr. Do not edit.
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <Arduino.h>
+
+#define SPR_MANA_VARIANTS 5
+
+struct SpriteDef {
+  uint8_t w, h;
+  uint8_t spanCount;
+  const uint8_t* spans;
+  const uint16_t* pixels;
+};
+
+enum SpriteId : uint8_t {
+  SPR_ARENA_PLAYER = 0,
+  SPR_DODGER = 1,
+  SPR_ENEMY = 2,  // + colour index
+  SPR_FOOD = 7,  // + colour index
+  SPR_GHOST = 12,
+  SPR_MANA_ORB = 13,  // + colour index
+  SPR_RUNNER = 18,
+  SPR_SNAKE_BODY = 19,
+  SPR_SNAKE_HEAD = 20,
+  SPR_SPELL = 21,  // + colour index
+  SPR_COUNT = 26
+};
+
+static const uint8_t SPR_ARENA_PLAYER_SPANS[] PROGMEM = {
+  0, 3, 5, 1, 2, 7, 2, 1, 9, 3, 0, 11,
+  4, 0, 11, 5, 0, 11, 6, 0, 11, 7, 0, 11,
+  8, 1, 9, 9, 2, 7, 10, 3, 5,
+};
+static const uint16_t SPR_ARENA_PLAYER_PIXELS[] PROGMEM = {
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+};
+
+static const uint8_t SPR_DODGER_SPANS[] PROGMEM = {
+  0, 0, 12, 1, 0, 12, 2, 0, 12, 3, 0, 12,
+  4, 0, 12, 5, 0, 12, 6, 0, 12, 7, 0, 12,
+};
+static const uint16_t SPR_DODGER_PIXELS[] PROGMEM = {
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B,
+  0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+};
+
+static const uint8_t SPR_ENEMY_0_SPANS[] PROGMEM = {
+  0, 1, 4, 1, 0, 6, 2, 0, 6, 3, 0, 6,
+  4, 0, 6, 5, 0, 1, 5, 2, 2, 5, 5, 1,
+};
+static const uint16_t SPR_ENEMY_0_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0x4529, 0xFFFF, 0xFFFF, 0x4529, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B, 0xFFFF, 0xFFFF, 0xEF7B, 0xFFFF, 0xFFFF, 0xEF7B,
+  0xEF7B, 0xFFFF,
+};
+
+static const uint8_t SPR_ENEMY_1_SPANS[] PROGMEM = {
+  0, 1, 4, 1, 0, 6, 2, 0, 6, 3, 0, 6,
+  4, 0, 6, 5, 0, 1, 5, 2, 2, 5, 5, 1,
+};
+static const uint16_t SPR_ENEMY_1_PIXELS[] PROGMEM = {
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x4529, 0x7F3B, 0x7F3B, 0x4529, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0xAF19, 0x7F3B, 0x7F3B, 0xAF19, 0x7F3B, 0x7F3B, 0xAF19,
+  0xAF19, 0x7F3B,
+};
+
+static const uint8_t SPR_ENEMY_2_SPANS[] PROGMEM = {
+  0, 1, 4, 1, 0, 6, 2, 0, 6, 3, 0, 6,
+  4, 0, 6, 5, 0, 1, 5, 2, 2, 5, 5, 1,
+};
+static const uint16_t SPR_ENEMY_2_PIXELS[] PROGMEM = {
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x4529, 0x00F8, 0x00F8, 0x4529, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0x0078, 0x00F8, 0x00F8, 0x0078, 0x00F8, 0x00F8, 0x0078,
+  0x0078, 0x00F8,
+};
+
+static const uint8_t SPR_ENEMY_3_SPANS[] PROGMEM = {
+  0, 1, 4, 1, 0, 6, 2, 0, 6, 3, 0, 6,
+  4, 0, 6, 5, 0, 1, 5, 2, 2, 5, 5, 1,
+};
+static const uint16_t SPR_ENEMY_3_PIXELS[] PROGMEM = {
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0x4529, 0xE007, 0xE007, 0x4529, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE003, 0xE007, 0xE007, 0xE003, 0xE007, 0xE007, 0xE003,
+  0xE003, 0xE007,
+};
+
+static const uint8_t SPR_ENEMY_4_SPANS[] PROGMEM = {
+  0, 1, 4, 1, 0, 6, 2, 0, 6, 3, 0, 6,
+  4, 0, 6, 5, 0, 1, 5, 2, 2, 5, 5, 1,
+};
+static const uint16_t SPR_ENEMY_4_PIXELS[] PROGMEM = {
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0x4529, 0xDFC8, 0xDFC8, 0x4529, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0x6F60, 0xDFC8, 0xDFC8, 0x6F60, 0xDFC8, 0xDFC8, 0x6F60,
+  0x6F60, 0xDFC8,
+};
+
+static const uint8_t SPR_FOOD_0_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_FOOD_0_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B, 0xEF7B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xEF7B, 0xEF7B, 0xEF7B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+static const uint8_t SPR_FOOD_1_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_FOOD_1_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0xFFFF, 0xFFFF, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF,
+  0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xAF19, 0xFFFF, 0xFFFF, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xAF19, 0xAF19, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B,
+  0xAF19, 0xAF19, 0xAF19, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+static const uint8_t SPR_FOOD_2_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_FOOD_2_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0xFFFF, 0xFFFF, 0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8,
+  0xFFFF, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0xFFFF,
+  0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0xFFFF, 0xFFFF,
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x0078, 0xFFFF, 0xFFFF, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x0078, 0x0078, 0xFFFF, 0xFFFF, 0x00F8, 0x00F8,
+  0x0078, 0x0078, 0x0078, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+static const uint8_t SPR_FOOD_3_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_FOOD_3_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xFFFF, 0xFFFF, 0xE007, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xFFFF, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xFFFF,
+  0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xFFFF, 0xFFFF,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE003, 0xFFFF, 0xFFFF, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE003, 0xE003, 0xFFFF, 0xFFFF, 0xE007, 0xE007,
+  0xE003, 0xE003, 0xE003, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+static const uint8_t SPR_FOOD_4_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_FOOD_4_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xFFFF, 0xFFFF, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xFFFF, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF,
+  0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF, 0xFFFF,
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0x6F60, 0xFFFF, 0xFFFF, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0x6F60, 0x6F60, 0xFFFF, 0xFFFF, 0xDFC8, 0xDFC8,
+  0x6F60, 0x6F60, 0x6F60, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+static const uint8_t SPR_GHOST_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 1, 1, 7, 1, 2, 0, 1,
+  2, 8, 1, 3, 0, 1, 3, 8, 1, 4, 0, 1,
+  4, 8, 1, 5, 0, 1, 5, 8, 1, 6, 0, 1,
+  6, 8, 1, 7, 1, 1, 7, 7, 1, 8, 2, 5,
+};
+static const uint16_t SPR_GHOST_PIXELS[] PROGMEM = {
+  0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B,
+  0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B,
+  0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B,
+};
+
+static const uint8_t SPR_MANA_ORB_0_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_MANA_ORB_0_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B, 0xEF7B, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B, 0xEF7B,
+};
+
+static const uint8_t SPR_MANA_ORB_1_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_MANA_ORB_1_PIXELS[] PROGMEM = {
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xAF19, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xAF19, 0xAF19, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0xAF19, 0xAF19, 0xAF19, 0xAF19, 0xAF19, 0xAF19, 0xAF19,
+};
+
+static const uint8_t SPR_MANA_ORB_2_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_MANA_ORB_2_PIXELS[] PROGMEM = {
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0xFFFF, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x0078, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x0078, 0x0078, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0x0078, 0x0078, 0x0078, 0x0078, 0x0078, 0x0078, 0x0078,
+};
+
+static const uint8_t SPR_MANA_ORB_3_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_MANA_ORB_3_PIXELS[] PROGMEM = {
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xFFFF, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xFFFF, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE003, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE003, 0xE003, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE003, 0xE003, 0xE003, 0xE003, 0xE003, 0xE003, 0xE003,
+};
+
+static const uint8_t SPR_MANA_ORB_4_SPANS[] PROGMEM = {
+  0, 2, 5, 1, 1, 7, 2, 0, 9, 3, 0, 9,
+  4, 0, 9, 5, 0, 9, 6, 0, 9, 7, 1, 7,
+  8, 2, 5,
+};
+static const uint16_t SPR_MANA_ORB_4_PIXELS[] PROGMEM = {
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0x6F60, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0x6F60, 0x6F60, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0x6F60, 0x6F60, 0x6F60, 0x6F60, 0x6F60, 0x6F60, 0x6F60,
+};
+
+static const uint8_t SPR_RUNNER_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_RUNNER_PIXELS[] PROGMEM = {
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B,
+  0x7F3B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B,
+};
+
+static const uint8_t SPR_SNAKE_BODY_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_SNAKE_BODY_PIXELS[] PROGMEM = {
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE003, 0xE007,
+  0xE007, 0xE003, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE003, 0xE007, 0xE007, 0xE003, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007,
+};
+
+static const uint8_t SPR_SNAKE_HEAD_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_SNAKE_HEAD_PIXELS[] PROGMEM = {
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x4529, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0x4529, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+static const uint8_t SPR_SPELL_0_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_SPELL_0_PIXELS[] PROGMEM = {
+  0xEF7B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B, 0xFFFF, 0xFFFF, 0xFFFF,
+  0xFFFF, 0xFFFF, 0xFFFF, 0xEF7B,
+};
+
+static const uint8_t SPR_SPELL_1_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_SPELL_1_PIXELS[] PROGMEM = {
+  0xAF19, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xAF19, 0x7F3B, 0x7F3B,
+  0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0x7F3B,
+  0xFFFF, 0x7F3B, 0x7F3B, 0xFFFF, 0x7F3B, 0x7F3B, 0xAF19, 0x7F3B, 0x7F3B, 0x7F3B,
+  0x7F3B, 0x7F3B, 0x7F3B, 0xAF19,
+};
+
+static const uint8_t SPR_SPELL_2_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_SPELL_2_PIXELS[] PROGMEM = {
+  0x0078, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x0078, 0x00F8, 0x00F8,
+  0xFFFF, 0x00F8, 0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0xFFFF, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0xFFFF, 0xFFFF, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0xFFFF, 0xFFFF, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x00F8, 0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x00F8,
+  0xFFFF, 0x00F8, 0x00F8, 0xFFFF, 0x00F8, 0x00F8, 0x0078, 0x00F8, 0x00F8, 0x00F8,
+  0x00F8, 0x00F8, 0x00F8, 0x0078,
+};
+
+static const uint8_t SPR_SPELL_3_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_SPELL_3_PIXELS[] PROGMEM = {
+  0xE003, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xE003, 0xE007, 0xE007,
+  0xFFFF, 0xE007, 0xE007, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xFFFF, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007, 0xFFFF, 0xFFFF, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE007, 0xE007, 0xFFFF, 0xFFFF, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xFFFF, 0xE007, 0xE007, 0xE007, 0xE007, 0xFFFF, 0xE007, 0xE007, 0xE007,
+  0xFFFF, 0xE007, 0xE007, 0xFFFF, 0xE007, 0xE007, 0xE003, 0xE007, 0xE007, 0xE007,
+  0xE007, 0xE007, 0xE007, 0xE003,
+};
+
+static const uint8_t SPR_SPELL_4_SPANS[] PROGMEM = {
+  0, 0, 8, 1, 0, 8, 2, 0, 8, 3, 0, 8,
+  4, 0, 8, 5, 0, 8, 6, 0, 8, 7, 0, 8,
+};
+static const uint16_t SPR_SPELL_4_PIXELS[] PROGMEM = {
+  0x6F60, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0x6F60, 0xDFC8, 0xDFC8,
+  0xFFFF, 0xDFC8, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF, 0xFFFF, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xFFFF, 0xDFC8, 0xDFC8, 0xFFFF, 0xDFC8, 0xDFC8, 0x6F60, 0xDFC8, 0xDFC8, 0xDFC8,
+  0xDFC8, 0xDFC8, 0xDFC8, 0x6F60,
+};
+
+static const SpriteDef SPRITES[SPR_COUNT] PROGMEM = {  // 3845 bytes of span data
+  { 11, 11, 11, SPR_ARENA_PLAYER_SPANS, SPR_ARENA_PLAYER_PIXELS },
+  { 12, 8, 8, SPR_DODGER_SPANS, SPR_DODGER_PIXELS },
+  { 6, 6, 8, SPR_ENEMY_0_SPANS, SPR_ENEMY_0_PIXELS },
+  { 6, 6, 8, SPR_ENEMY_1_SPANS, SPR_ENEMY_1_PIXELS },
+  { 6, 6, 8, SPR_ENEMY_2_SPANS, SPR_ENEMY_2_PIXELS },
+  { 6, 6, 8, SPR_ENEMY_3_SPANS, SPR_ENEMY_3_PIXELS },
+  { 6, 6, 8, SPR_ENEMY_4_SPANS, SPR_ENEMY_4_PIXELS },
+  { 9, 9, 9, SPR_FOOD_0_SPANS, SPR_FOOD_0_PIXELS },
+  { 9, 9, 9, SPR_FOOD_1_SPANS, SPR_FOOD_1_PIXELS },
+  { 9, 9, 9, SPR_FOOD_2_SPANS, SPR_FOOD_2_PIXELS },
+  { 9, 9, 9, SPR_FOOD_3_SPANS, SPR_FOOD_3_PIXELS },
+  { 9, 9, 9, SPR_FOOD_4_SPANS, SPR_FOOD_4_PIXELS },
+  { 9, 9, 16, SPR_GHOST_SPANS, SPR_GHOST_PIXELS },
+  { 9, 9, 9, SPR_MANA_ORB_0_SPANS, SPR_MANA_ORB_0_PIXELS },
+  { 9, 9, 9, SPR_MANA_ORB_1_SPANS, SPR_MANA_ORB_1_PIXELS },
+  { 9, 9, 9, SPR_MANA_ORB_2_SPANS, SPR_MANA_ORB_2_PIXELS },
+  { 9, 9, 9, SPR_MANA_ORB_3_SPANS, SPR_MANA_ORB_3_PIXELS },
+  { 9, 9, 9, SPR_MANA_ORB_4_SPANS, SPR_MANA_ORB_4_PIXELS },
+  { 8, 8, 8, SPR_RUNNER_SPANS, SPR_RUNNER_PIXELS },
+  { 8, 8, 8, SPR_SNAKE_BODY_SPANS, SPR_SNAKE_BODY_PIXELS },
+  { 8, 8, 8, SPR_SNAKE_HEAD_SPANS, SPR_SNAKE_HEAD_PIXELS },
+  { 8, 8, 8, SPR_SPELL_0_SPANS, SPR_SPELL_0_PIXELS },
+  { 8, 8, 8, SPR_SPELL_1_SPANS, SPR_SPELL_1_PIXELS },
+  { 8, 8, 8, SPR_SPELL_2_SPANS, SPR_SPELL_2_PIXELS },
+  { 8, 8, 8, SPR_SPELL_3_SPANS, SPR_SPELL_3_PIXELS },
+  { 8, 8, 8, SPR_SPELL_4_SPANS, SPR_SPELL_4_PIXELS },
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include "telemetry.h"
+#include <string.h>
+
+struct TelemetryBlock {
+  uint32_t firstSeq;
+  uint16_t count;
+  uint16_t used;
+  uint16_t intervalS;
+  int16_t base[TELE_CHANNELS];
+  uint8_t data[TELEMETRY_BLOCK_BYTES];
+};
+
+static TelemetryBlock blocks[TELEMETRY_BLOCKS];
+static uint8_t oldest = 0;
+static uint8_t blockCount = 0;
+static uint32_t endSeq = 0;
+static int16_t last[TELE_CHANNELS];
+
+static inline uint32_t zigzag(int32_t v) {
+  return (uint32_t)((v << 1) ^ (v >> 31));
+}
+
+static inline int32_t unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+void telemetryReset() {
+  oldest = 0;
+  blockCount = 0;
+  endSeq = 0;
+  memset(last, 0, sizeof(last));
+}
+
+static TelemetryBlock& openBlock(const int16_t values[TELE_CHANNELS], uint16_t intervalS) {
+  if (blockCount == TELEMETRY_BLOCKS) {
+    oldest = (oldest + 1) % TELEMETRY_BLOCKS;
+    blockCount--;
+  }
+  TelemetryBlock& b = blocks[(oldest + blockCount) % TELEMETRY_BLOCKS];
+  blockCount++;
+  b.firstSeq = endSeq;
+  b.count = 0;
+  b.used = 0;
+  b.intervalS = intervalS;
+  memcpy(b.base, values, sizeof(b.base));
+  memcpy(last, values, sizeof(last));
+  return b;
+}
+
+void telemetryAppend(const int16_t values[TELE_CHANNELS], uint16_t intervalS) {
+  uint8_t rec[1 + TELE_CHANNELS * 3];
+  uint8_t len = 1;
+  uint8_t mask = 0;
+  for (uint8_t ch = 0; ch < TELE_CHANNELS; ch++) {
+    int32_t d = (int32_t)values[ch] - last[ch];
+    if (d == 0) continue;
+    mask |= 1 << ch;
+    uint32_t z = zigzag(d);
+    do {
+      uint8_t byte = z & 0x7F;
+      z >>= 7;
+      rec[len++] = byte | (z ? 0x80 : 0);
+    } while (z);
+  }
+  rec[0] = mask;
+
+  TelemetryBlock* b = blockCount ? &blocks[(oldest + blockCount - 1) % TELEMETRY_BLOCKS] : nullptr;
+  if (!b || b->intervalS != intervalS || b->used + len > TELEMETRY_BLOCK_BYTES) {
+    b = &openBlock(values, intervalS);
+    rec[0] = 0;
+    len = 1;
+  }
+  memcpy(b->data + b->used, rec, len);
+  b->used += len;
+  b->count++;
+  memcpy(last, values, sizeof(last));
+  endSeq++;
+}
+
+uint32_t telemetryFirstSeq() {
+  return blockCount ? blocks[oldest].firstSeq : endSeq;
+}
+
+uint32_t telemetryEndSeq() {
+  return endSeq;
+}
+
+uint32_t telemetrySpanSeconds() {
+  uint32_t s = 0;
+  for (uint8_t i = 0; i < blockCount; i++) {
+    const TelemetryBlock& b = blocks[(oldest + i) % TELEMETRY_BLOCKS];
+    s += (uint32_t)b.count * b.intervalS;
+  }
+  return s;
+}
+
+int16_t telemetryLatest(uint8_t channel) {
+  return (channel < TELE_CHANNELS) ? last[channel] : 0;
+}
+
+void telemetryColumns(uint8_t channel, uint16_t spp, uint32_t firstCol, uint16_t cols, int16_t* lo, int16_t* hi) {
+  for (uint16_t c = 0; c < cols; c++) {
+    lo[c] = INT16_MAX;
+    hi[c] = INT16_MIN;
+  }
+  if (channel >= TELE_CHANNELS || spp == 0) return;
+  uint32_t from = firstCol * spp;
+  uint32_t to = from + (uint32_t)cols * spp;
+
+  for (uint8_t i = 0; i < blockCount; i++) {
+    const TelemetryBlock& b = blocks[(oldest + i) % TELEMETRY_BLOCKS];
+    if (b.firstSeq + b.count <= from) continue;
+    if (b.firstSeq >= to) break;
+
+    int32_t v = b.base[channel];
+    uint16_t pos = 0;
+    for (uint16_t k = 0; k < b.count; k++) {
+      uint8_t mask = b.data[pos++];
+      for (uint8_t ch = 0; ch < TELE_CHANNELS; ch++) {
+        if (!(mask & (1 << ch))) continue;
+        uint32_t z = 0;
+        uint8_t shift = 0;
+        uint8_t byte;
+        do {
+          byte = b.data[pos++];
+          z |= (uint32_t)(byte & 0x7F) << shift;
+          shift += 7;
+        } while (byte & 0x80);
+        if (ch == channel) v += unzigzag(z);
+      }
+
+      uint32_t seq = b.firstSeq + k;
+      if (seq < from) continue;
+      if (seq >= to) return;
+      uint16_t c = (seq - from) / spp;
+      if (v < lo[c]) lo[c] = v;
+      if (v > hi[c]) hi[c] = v;
+    }
+  }
+}
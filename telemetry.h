@@ -0,0 +1,38 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+// Fixed-memory recorder for slow-moving system values. Samples are packed
+// into TELEMETRY_BLOCKS blocks of TELEMETRY_BLOCK_BYTES; each block keeps
+// its first sample in full and every later one as a byte holding which
+// channels changed followed by their zigzag LEB128 deltas, so a quiet
+// sample costs one byte. When the ring is full the oldest block is
+// dropped. Sequence numbers count every sample ever appended.
+#define TELEMETRY_BLOCKS       48
+#define TELEMETRY_BLOCK_BYTES  250
+#define TELEMETRY_HEAP_UNIT    64
+
+enum TelemetryChannel : uint8_t {
+  TELE_BATT_MV,
+  TELE_BATT_PCT,
+  TELE_TEMP_DC,     // chip temperature, tenths of a degree C
+  TELE_HEAP,        // free heap in TELEMETRY_HEAP_UNIT bytes
+  TELE_CPU_MHZ,
+  TELE_CHANNELS
+};
+
+void telemetryReset();
+// intervalS is kept per block so the time axis survives a rate change.
+void telemetryAppend(const int16_t values[TELE_CHANNELS], uint16_t intervalS);
+uint32_t telemetryFirstSeq();
+uint32_t telemetryEndSeq();
+// Seconds covered by the samples still in the ring.
+uint32_t telemetrySpanSeconds();
+int16_t telemetryLatest(uint8_t channel);
+// Min/max of channel over cols columns of spp samples each, column c
+// covering sequence numbers [(firstCol + c) * spp, (firstCol + c + 1) * spp).
+// A column with no samples gets lo > hi.
+void telemetryColumns(uint8_t channel, uint16_t spp, uint32_t firstCol, uint16_t cols, int16_t* lo, int16_t* hi);
+
+#endif
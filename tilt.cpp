@@ -0,0 +1,163 @@
+#include "tilt.h"
+#include "mahony.h"
+#include "perf.h"
+#include <M5Unified.h>
+
+#define DEG_TO_RAD_Q16  1144  // pi / 180 in Q16
+
+static TaskHandle_t tiltTask = nullptr;
+static volatile bool wantRun = false;
+static volatile bool running = false;
+static volatile bool calRestart = false;
+static portMUX_TYPE tiltLock = portMUX_INITIALIZER_UNLOCKED;
+
+static MahonyState filter;
+static uint32_t filterUsSum;
+
+// Guarded by tiltLock.
+static TiltStats stats;
+static int32_t gravity[3];
+static int32_t neutral[3];
+static bool calibrated = false;
+
+static int64_t calSum[3];
+static uint8_t calSamples;
+
+static inline int32_t toQ16(float v) {
+  return (int32_t)(v * (1 << MAHONY_IN_Q));
+}
+
+static void resetCal() {
+  calSum[0] = calSum[1] = calSum[2] = 0;
+  calSamples = 0;
+  portENTER_CRITICAL(&tiltLock);
+  calibrated = false;
+  portEXIT_CRITICAL(&tiltLock);
+}
+
+// Averages the filtered gravity once the warm-up has settled it.
+static void calibrateStep(const int32_t v[3]) {
+  for (uint8_t i = 0; i < 3; i++) calSum[i] += v[i];
+  if (++calSamples < TILT_CAL_SAMPLES) return;
+  portENTER_CRITICAL(&tiltLock);
+  for (uint8_t i = 0; i < 3; i++) neutral[i] = (int32_t)(calSum[i] / calSamples);
+  calibrated = true;
+  portEXIT_CRITICAL(&tiltLock);
+}
+
+static void sample() {
+  unsigned long t0 = micros();
+  M5.Imu.update();
+  m5::imu_data_t d;
+  M5.Imu.getImuData(&d);
+  perfCountI2C();
+  unsigned long t1 = micros();
+
+  int32_t accel[3] = { toQ16(d.accel.x), toQ16(d.accel.y), toQ16(d.accel.z) };
+  int32_t gyro[3] = {
+    (int32_t)((int64_t)toQ16(d.gyro.x) * DEG_TO_RAD_Q16 >> MAHONY_IN_Q),
+    (int32_t)((int64_t)toQ16(d.gyro.y) * DEG_TO_RAD_Q16 >> MAHONY_IN_Q),
+    (int32_t)((int64_t)toQ16(d.gyro.z) * DEG_TO_RAD_Q16 >> MAHONY_IN_Q)
+  };
+  mahonyUpdate(filter, gyro, accel);
+  int32_t v[3];
+  mahonyGravity(filter, v);
+  unsigned long t2 = micros();
+
+  portENTER_CRITICAL(&tiltLock);
+  gravity[0] = v[0];
+  gravity[1] = v[1];
+  gravity[2] = v[2];
+  portEXIT_CRITICAL(&tiltLock);
+
+  if (calRestart) {
+    calRestart = false;
+    resetCal();
+  }
+  if (!calibrated && filter.samples >= MAHONY_WARMUP) calibrateStep(v);
+
+  uint16_t us = t2 - t1;
+  filterUsSum += us;
+  portENTER_CRITICAL(&tiltLock);
+  stats.readUs = t1 - t0;
+  stats.lastUs = us;
+  if (us > stats.maxUs) stats.maxUs = us;
+  if (us > TILT_FILTER_BUDGET_US) stats.overruns++;
+  stats.samples++;
+  stats.meanUs = filterUsSum / stats.samples;
+  portEXIT_CRITICAL(&tiltLock);
+}
+
+// Sleeps until tiltStart, then samples on a fixed period until tiltStop.
+static void tiltLoop(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    running = true;
+    mahonyInit(filter, TILT_HZ, TILT_KP, TILT_KP_WARM, TILT_KI);
+    calRestart = false;
+    resetCal();
+    portENTER_CRITICAL(&tiltLock);
+    memset(&stats, 0, sizeof(stats));
+    portEXIT_CRITICAL(&tiltLock);
+    filterUsSum = 0;
+
+    TickType_t wake = xTaskGetTickCount();
+    while (wantRun) {
+      sample();
+      vTaskDelayUntil(&wake, pdMS_TO_TICKS(TILT_PERIOD_MS));
+    }
+    running = false;
+  }
+}
+
+void tiltStart() {
+  if (wantRun) return;
+  wantRun = true;
+  if (!tiltTask) {
+    xTaskCreatePinnedToCore(tiltLoop, "tilt", TILT_TASK_STACK, nullptr, TILT_TASK_PRIORITY, &tiltTask, TILT_TASK_CORE);
+    perfWatchTask(tiltTask, "tilt");
+  }
+  xTaskNotifyGive(tiltTask);
+}
+
+void tiltStop() {
+  wantRun = false;
+  while (running) delay(1);
+}
+
+bool tiltActive() {
+  return wantRun || running;
+}
+
+void tiltRead(JoystickState& js) {
+  int32_t v[3], n[3];
+  bool cal;
+  portENTER_CRITICAL(&tiltLock);
+  memcpy(v, gravity, sizeof(v));
+  memcpy(n, neutral, sizeof(n));
+  cal = calibrated;
+  portEXIT_CRITICAL(&tiltLock);
+
+  js.connected = cal;
+  if (!cal) {
+    js.ax = js.ay = 0;
+    return;
+  }
+  // Tipping the right edge down moves "up" towards screen left, so the
+  // stick reads the opposite of the change in gravity.
+  const float k = -1.0f / (TILT_FULL_SCALE * MAHONY_ONE);
+  float sx = TILT_SCREEN_X_SIGN * ((float)v[TILT_SCREEN_X_AXIS] - n[TILT_SCREEN_X_AXIS]) * k;
+  float sy = TILT_SCREEN_Y_SIGN * ((float)v[TILT_SCREEN_Y_AXIS] - n[TILT_SCREEN_Y_AXIS]) * k;
+  joystickShape(sx, sy, js);
+}
+
+void tiltCalibrate() {
+  calRestart = true;
+}
+
+TiltStats tiltGetStats() {
+  portENTER_CRITICAL(&tiltLock);
+  TiltStats s = stats;
+  portEXIT_CRITICAL(&tiltLock);
+  return s;
+}
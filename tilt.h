@@ -0,0 +1,54 @@
+#ifndef TILT_H
+#define TILT_H
+
+#include <stdint.h>
+#include "joystick.h"
+
+// Tilt control: a task on core 0 (the sketch loop runs on core 1) samples
+// the MPU6886 every TILT_PERIOD_MS and feeds it through the fixed-point
+// Mahony filter in mahony.h. Readers get the tilt away from the neutral
+// pose shaped like a Joystick HAT sample, so the minigames need no change.
+#define TILT_PERIOD_MS      5
+#define TILT_HZ             (1000 / TILT_PERIOD_MS)
+#define TILT_TASK_STACK     3072
+#define TILT_TASK_PRIORITY  2
+#define TILT_TASK_CORE      0
+#define TILT_KP             2.0f
+#define TILT_KP_WARM        20.0f
+#define TILT_KI             0.05f
+#define TILT_CAL_SAMPLES    32
+#define TILT_FILTER_BUDGET_US  100
+
+// Full deflection at about 20 degrees from neutral (sin 20 = 0.342).
+#define TILT_FULL_SCALE     0.342f
+
+// Body axis (0 = X, 1 = Y) and sign that point along screen right and
+// screen down with the display at rotation 1.
+#define TILT_SCREEN_X_AXIS  1
+#define TILT_SCREEN_X_SIGN  (-1)
+#define TILT_SCREEN_Y_AXIS  0
+#define TILT_SCREEN_Y_SIGN  (-1)
+
+struct TiltStats {
+  uint32_t samples;
+  uint32_t overruns;
+  uint16_t lastUs;
+  uint16_t maxUs;
+  uint16_t meanUs;
+  uint16_t readUs;
+};
+
+// Wakes the task and re-learns the neutral pose; safe to call again.
+void tiltStart();
+// Returns once the task has stopped touching the IMU.
+void tiltStop();
+bool tiltActive();
+// Fills ax/ay like joystickRead; leaves button and the raw axes alone.
+// connected stays false until the neutral pose is known.
+void tiltRead(JoystickState& js);
+// Takes the current pose as neutral.
+void tiltCalibrate();
+// Filter cost of the last tilt session; kept after tiltStop.
+TiltStats tiltGetStats();
+
+#endif
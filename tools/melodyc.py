@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Compile melodies/*.mel into melodies.h (PROGMEM byte arrays).
+
+Usage: python3 tools/melodyc.py [melodies_dir] [output_header]
+
+Notation, whitespace separated, ';' starts a comment:
+  tempo N        milliseconds per tick
+  gap N          silent ticks at the end of every following note
+  C5:12          note (C..B, optional # or b, octave -1..9) for 12 ticks
+  r:4            rest for 4 ticks
+  800hz:5        raw frequency for 5 ticks
+  [ ... ]x3      play the enclosed notes 3 times (no nesting)
+
+Bytecode (read by audio.cpp):
+  0x00-0x7F n t  MIDI note n (0 = rest) for t ticks
+  0x80           END
+  0x81 m         TEMPO m ms per tick
+  0x82 g         GAP g ticks
+  0x83 c         LOOP start, play c times
+  0x84           LOOP end
+  0x85 hi lo t   raw frequency (big endian) for t ticks
+"""
+import os
+import re
+import sys
+
+OP_END, OP_TEMPO, OP_GAP, OP_LOOP, OP_ENDLOOP, OP_HZ = 0x80, 0x81, 0x82, 0x83, 0x84, 0x85
+
+NOTE_BASE = {"C": 0, "D": 2, "E": 4, "F": 5, "G": 7, "A": 9, "B": 11}
+NOTE_RE = re.compile(r"^([A-G])([#b]?)(-?\d):(\d+)$")
+HZ_RE = re.compile(r"^(\d+)hz:(\d+)$")
+REST_RE = re.compile(r"^r:(\d+)$")
+
+
+def fail(path, msg):
+    sys.exit("%s: %s" % (path, msg))
+
+
+def byte(path, value, what):
+    if not 0 <= value <= 255:
+        fail(path, "%s %d out of range 0-255" % (what, value))
+    return value
+
+
+def compile_melody(path, text):
+    out = []
+    in_loop = False
+    tokens = []
+    for line in text.splitlines():
+        tokens += line.split(";", 1)[0].split()
+
+    i = 0
+    while i < len(tokens):
+        tok = tokens[i]
+        if tok in ("tempo", "gap"):
+            if i + 1 >= len(tokens):
+                fail(path, "%s needs a value" % tok)
+            out += [OP_TEMPO if tok == "tempo" else OP_GAP, byte(path, int(tokens[i + 1]), tok)]
+            i += 2
+            continue
+        if tok == "[":
+            if in_loop:
+                fail(path, "nested loops are not supported")
+            in_loop = True
+            out += [OP_LOOP, 0]
+            loop_count_at = len(out) - 1
+        elif re.match(r"^\]x\d+$", tok):
+            if not in_loop:
+                fail(path, "']' without '['")
+            in_loop = False
+            out[loop_count_at] = byte(path, int(tok[2:]), "loop count")
+            out.append(OP_ENDLOOP)
+        elif NOTE_RE.match(tok):
+            name, acc, octave, ticks = NOTE_RE.match(tok).groups()
+            midi = (int(octave) + 1) * 12 + NOTE_BASE[name] + {"#": 1, "b": -1, "": 0}[acc]
+            if not 1 <= midi <= 127:
+                fail(path, "note %s out of MIDI range" % tok)
+            out += [midi, byte(path, int(ticks), "ticks")]
+        elif REST_RE.match(tok):
+            out += [0, byte(path, int(REST_RE.match(tok).group(1)), "ticks")]
+        elif HZ_RE.match(tok):
+            hz, ticks = (int(v) for v in HZ_RE.match(tok).groups())
+            if not 1 <= hz <= 0xFFFF:
+                fail(path, "frequency %d out of range" % hz)
+            out += [OP_HZ, hz >> 8, hz & 0xFF, byte(path, ticks, "ticks")]
+        else:
+            fail(path, "unknown token '%s'" % tok)
+        i += 1
+
+    if in_loop:
+        fail(path, "unterminated loop")
+    out.append(OP_END)
+    return out
+
+
+def main():
+    src_dir = sys.argv[1] if len(sys.argv) > 1 else "melodies"
+    header = sys.argv[2] if len(sys.argv) > 2 else "melodies.h"
+
+    lines = [
+        "// Generated by tools/melodyc.py from %s/*.mel. Do not edit." % src_dir,
+        "#ifndef MELODIES_H",
+        "#define MELODIES_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define MEL_END     0x80",
+        "#define MEL_TEMPO   0x81",
+        "#define MEL_GAP     0x82",
+        "#define MEL_LOOP    0x83",
+        "#define MEL_ENDLOOP 0x84",
+        "#define MEL_HZ      0x85",
+    ]
+    for name in sorted(os.listdir(src_dir)):
+        if not name.endswith(".mel"):
+            continue
+        path = os.path.join(src_dir, name)
+        with open(path) as f:
+            data = compile_melody(path, f.read())
+        ident = "MEL_" + re.sub(r"\W", "_", name[:-4]).upper()
+        lines += ["", "static const uint8_t %s[] PROGMEM = {  // %d bytes" % (ident, len(data))]
+        for j in range(0, len(data), 12):
+            lines.append("  " + ", ".join("0x%02X" % b for b in data[j:j + 12]) + ",")
+        lines.append("};")
+    lines += ["", "#endif", ""]
+
+    with open(header, "w") as f:
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
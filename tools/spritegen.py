@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""Rasterize sprites/*.spr into sprites.h (PROGMEM span lists).
+
+Usage: python3 tools/spritegen.py [sprites_dir] [output_header] [config_header]
+
+A .spr file is pixel art, one character per pixel; ';' starts a comment.
+  .        transparent (the colour key; never stored)
+  W U G K  MTG_WHITE, MTG_BLUE, MTG_GREEN, MTG_BLACK from config.h
+  T        COLOR_TEXT from config.h
+  M        mana colour: the sprite gets one variant per MANA_PALETTE entry
+  a-z      the upper case colour at half brightness
+
+Each sprite is stored as its opaque horizontal runs. SPRITE_SPANS holds
+(y, x, length) triples and SPRITE_PIXELS the run pixels back to back,
+byte-swapped RGB565 as laid out in an M5Canvas buffer, so the blitter in
+display.cpp copies each run with one memcpy and never tests for the key.
+Sprites using M are numbered SPR_<NAME> + colour index.
+"""
+import os
+import re
+import sys
+
+PALETTE_NAMES = {"W": "MTG_WHITE", "U": "MTG_BLUE", "G": "MTG_GREEN", "K": "MTG_BLACK", "T": "COLOR_TEXT"}
+
+# Order matches the colour index the minigames pick (colorIdx).
+MANA_PALETTE = ["MTG_WHITE", "MTG_BLUE", "MTG_RED", "MTG_GREEN", "0xC8DF"]
+
+
+def fail(path, msg):
+    sys.exit("%s: %s" % (path, msg))
+
+
+def read_defines(config):
+    defines = {}
+    with open(config) as f:
+        for m in re.finditer(r"^#define\s+(\w+)\s+(0x[0-9A-Fa-f]+)\b", f.read(), re.M):
+            defines[m.group(1)] = int(m.group(2), 16)
+    return defines
+
+
+def resolve(defines, name):
+    return int(name, 16) if name.startswith("0x") else defines[name]
+
+
+def half(color):
+    return (color >> 1) & 0x7BEF
+
+
+def swap(color):
+    return ((color & 0xFF) << 8) | (color >> 8)
+
+
+def load(path):
+    rows = []
+    with open(path) as f:
+        for line in f:
+            line = line.split(";", 1)[0].rstrip()
+            if line:
+                rows.append(line)
+    if not rows:
+        fail(path, "empty sprite")
+    width = len(rows[0])
+    if any(len(r) != width for r in rows):
+        fail(path, "rows must all be %d pixels wide" % width)
+    if width > 255 or len(rows) > 255:
+        fail(path, "sprite larger than 255x255")
+    return rows
+
+
+def rasterize(path, rows, palette):
+    spans, pixels = [], []
+    for y, row in enumerate(rows):
+        x = 0
+        while x < len(row):
+            if row[x] == ".":
+                x += 1
+                continue
+            start = x
+            while x < len(row) and row[x] != "." and x - start < 255:
+                ch = row[x]
+                base = ch.upper()
+                if base not in palette:
+                    fail(path, "unknown colour '%s' at %d,%d" % (ch, x, y))
+                color = palette[base] if ch.isupper() else half(palette[base])
+                pixels.append(swap(color))
+                x += 1
+            spans += [y, start, x - start]
+    if len(spans) // 3 > 255:
+        fail(path, "more than 255 runs")
+    return spans, pixels
+
+
+def main():
+    src_dir = sys.argv[1] if len(sys.argv) > 1 else "sprites"
+    header = sys.argv[2] if len(sys.argv) > 2 else "sprites.h"
+    config = sys.argv[3] if len(sys.argv) > 3 else "config.h"
+
+    defines = read_defines(config)
+    base_palette = {ch: defines[name] for ch, name in PALETTE_NAMES.items()}
+    mana = [resolve(defines, name) for name in MANA_PALETTE]
+
+    sprites = []
+    ids = []
+    for name in sorted(os.listdir(src_dir)):
+        if not name.endswith(".spr"):
+            continue
+        path = os.path.join(src_dir, name)
+        rows = load(path)
+        ident = "SPR_" + re.sub(r"\W", "_", name[:-4]).upper()
+        variants = mana if any("M" in r.upper() for r in rows) else [None]
+        ids.append((ident, len(sprites), len(variants)))
+        for i, color in enumerate(variants):
+            palette = dict(base_palette)
+            if color is not None:
+                palette["M"] = color
+            spans, pixels = rasterize(path, rows, palette)
+            suffix = "" if color is None else "_%d" % i
+            sprites.append((ident + suffix, len(rows[0]), len(rows), spans, pixels))
+
+    lines = [
+        "// Generated by tools/spritegen.py from %s/*.spr. Do not edit." % src_dir,
+        "#ifndef SPRITES_H",
+        "#define SPRITES_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define SPR_MANA_VARIANTS %d" % len(mana),
+        "",
+        "struct SpriteDef {",
+        "  uint8_t w, h;",
+        "  uint8_t spanCount;",
+        "  const uint8_t* spans;",
+        "  const uint16_t* pixels;",
+        "};",
+        "",
+        "enum SpriteId : uint8_t {",
+    ]
+    for ident, first, count in ids:
+        lines.append("  %s = %d,%s" % (ident, first, "  // + colour index" if count > 1 else ""))
+    lines += ["  SPR_COUNT = %d" % len(sprites), "};"]
+
+    total = 0
+    for ident, w, h, spans, pixels in sprites:
+        total += len(spans) + 2 * len(pixels)
+        lines += ["", "static const uint8_t %s_SPANS[] PROGMEM = {" % ident]
+        for j in range(0, len(spans), 12):
+            lines.append("  " + ", ".join("%d" % v for v in spans[j:j + 12]) + ",")
+        lines += ["};", "static const uint16_t %s_PIXELS[] PROGMEM = {" % ident]
+        for j in range(0, len(pixels), 10):
+            lines.append("  " + ", ".join("0x%04X" % v for v in pixels[j:j + 10]) + ",")
+        lines.append("};")
+
+    lines += ["", "static const SpriteDef SPRITES[SPR_COUNT] PROGMEM = {  // %d bytes of span data" % total]
+    for ident, w, h, spans, pixels in sprites:
+        lines.append("  { %d, %d, %d, %s_SPANS, %s_PIXELS }," % (w, h, len(spans) // 3, ident, ident))
+    lines += ["};", "", "#endif", ""]
+
+    with open(header, "w") as f:
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
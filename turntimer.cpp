@@ -0,0 +1,98 @@
+#include "turntimer.h"
+#include <Arduino.h>
+
+static TurnAggregate aggregates[MAX_PLAYERS];
+static uint8_t turnLog[TURN_LOG_BYTES];
+static uint16_t turnLogLen = 0;
+
+static unsigned long pausedTotalMs = 0;
+static unsigned long pauseStartMs = 0;
+static bool paused = false;
+
+unsigned long turnTimerNow() {
+  return (paused ? pauseStartMs : millis()) - pausedTotalMs;
+}
+
+void turnTimerPause() {
+  if (paused) return;
+  pauseStartMs = millis();
+  paused = true;
+}
+
+void turnTimerResume() {
+  if (!paused) return;
+  pausedTotalMs += millis() - pauseStartMs;
+  paused = false;
+}
+
+bool turnTimerPaused() {
+  return paused;
+}
+
+void turnTimerReset() {
+  memset(aggregates, 0, sizeof(aggregates));
+  turnLogLen = 0;
+  turnTimerResume();
+}
+
+static uint8_t encodedSize(uint32_t seconds) {
+  uint8_t n = 1;
+  for (seconds >>= 4; seconds; seconds >>= 7) n++;
+  return n;
+}
+
+static void appendTurn(uint8_t player, uint32_t seconds) {
+  if (turnLogLen + encodedSize(seconds) > TURN_LOG_BYTES) return;
+
+  uint32_t rest = seconds >> 4;
+  turnLog[turnLogLen++] = (player << 5) | (rest ? 0x10 : 0) | (seconds & 0x0F);
+  while (rest) {
+    uint8_t b = rest & 0x7F;
+    rest >>= 7;
+    turnLog[turnLogLen++] = b | (rest ? 0x80 : 0);
+  }
+}
+
+void turnTimerEndTurn(uint8_t player, unsigned long durationMs) {
+  TurnAggregate& a = aggregates[player];
+  a.turns++;
+  a.totalMs += durationMs;
+  if (durationMs > a.maxMs) a.maxMs = durationMs;
+
+  appendTurn(player, (durationMs + 500) / 1000);
+}
+
+const TurnAggregate& turnTimerAggregate(uint8_t player) {
+  return aggregates[player];
+}
+
+unsigned long turnTimerMeanMs(uint8_t player) {
+  const TurnAggregate& a = aggregates[player];
+  return a.turns ? a.totalMs / a.turns : 0;
+}
+
+unsigned long turnTimerBankMs(uint8_t player, unsigned long runningMs) {
+  unsigned long used = aggregates[player].totalMs + runningMs;
+  return (used >= CHESS_CLOCK_BANK_MS) ? 0 : CHESS_CLOCK_BANK_MS - used;
+}
+
+uint16_t turnTimerLogBytes() {
+  return turnLogLen;
+}
+
+bool turnTimerLogNext(uint16_t& offset, uint8_t& player, uint32_t& seconds) {
+  if (offset >= turnLogLen) return false;
+
+  uint8_t b = turnLog[offset++];
+  player = b >> 5;
+  seconds = b & 0x0F;
+  bool more = b & 0x10;
+  uint8_t shift = 4;
+  while (more && offset < turnLogLen) {
+    b = turnLog[offset++];
+    seconds |= (uint32_t)(b & 0x7F) << shift;
+    shift += 7;
+    more = b & 0x80;
+  }
+  return true;
+}
@@ -0,0 +1,32 @@
+#ifndef TURNTIMER_H
+#define TURNTIMER_H
+
+#include "config.h"
+
+struct TurnAggregate {
+  uint16_t turns;
+  uint32_t totalMs;
+  uint32_t maxMs;
+};
+
+// The game clock is millis() minus every paused interval. All match and
+// turn timestamps are taken from it, so a pause (face down, match over)
+// is compensated in one place instead of by shifting each start time.
+unsigned long turnTimerNow();
+void turnTimerPause();
+void turnTimerResume();
+bool turnTimerPaused();
+
+void turnTimerReset();
+void turnTimerEndTurn(uint8_t player, unsigned long durationMs);
+const TurnAggregate& turnTimerAggregate(uint8_t player);
+unsigned long turnTimerMeanMs(uint8_t player);
+unsigned long turnTimerBankMs(uint8_t player, unsigned long runningMs);
+
+// Per-turn durations are kept in seconds as a byte stream: the first byte
+// holds the player (3 bits), a continuation flag and the low 4 bits of the
+// duration; remaining bits follow as LEB128. Turns under 16 s take 1 byte.
+uint16_t turnTimerLogBytes();
+bool turnTimerLogNext(uint16_t& offset, uint8_t& player, uint32_t& seconds);
+
+#endif